@@ -1508,6 +1508,70 @@ fs::native_handle fs::file::get_handle() const
 #endif
 }
 
+fs::file_map::file_map(const file& f)
+{
+	if (!f)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	const u64 size = f.size();
+
+	if (!size)
+	{
+		// Cannot map empty files
+		g_tls_error = error::inval;
+		return;
+	}
+
+#ifdef _WIN32
+	const HANDLE handle = ::CreateFileMappingW(f.get_handle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!handle)
+	{
+		g_tls_error = to_error(GetLastError());
+		return;
+	}
+
+	// The view keeps the mapping object alive
+	const auto ptr = ::MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+	const DWORD error = GetLastError();
+	ensure(::CloseHandle(handle));
+
+	if (!ptr)
+	{
+		g_tls_error = to_error(error);
+		return;
+	}
+#else
+	const auto ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, f.get_handle(), 0);
+
+	if (ptr == MAP_FAILED)
+	{
+		g_tls_error = to_error(errno);
+		return;
+	}
+#endif
+
+	m_ptr = static_cast<const u8*>(ptr);
+	m_size = size;
+}
+
+fs::file_map::~file_map()
+{
+	if (!m_ptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	ensure(::UnmapViewOfFile(m_ptr));
+#else
+	ensure(::munmap(const_cast<u8*>(m_ptr), m_size) != -1);
+#endif
+}
+
 bool fs::dir::open(const std::string& path)
 {
 	if (path.empty())
@@ -499,6 +499,53 @@ namespace fs
 		}
 	};
 
+	// Read-only memory mapping of the whole file
+	class file_map final
+	{
+		const u8* m_ptr{};
+		u64 m_size{};
+
+	public:
+		file_map() = default;
+
+		// Map file contents (the file handle may be closed afterwards)
+		explicit file_map(const file& f);
+
+		file_map(const file_map&) = delete;
+
+		file_map& operator=(const file_map&) = delete;
+
+		file_map(file_map&& r) noexcept
+			: m_ptr(std::exchange(r.m_ptr, nullptr))
+			, m_size(std::exchange(r.m_size, 0))
+		{
+		}
+
+		file_map& operator=(file_map&& r) noexcept
+		{
+			std::swap(m_ptr, r.m_ptr);
+			std::swap(m_size, r.m_size);
+			return *this;
+		}
+
+		~file_map();
+
+		explicit operator bool() const
+		{
+			return m_ptr != nullptr;
+		}
+
+		const u8* data() const
+		{
+			return m_ptr;
+		}
+
+		u64 size() const
+		{
+			return m_size;
+		}
+	};
+
 	class dir final
 	{
 		std::unique_ptr<dir_base> m_dir{};
@@ -9,6 +9,7 @@
 #include "util/asm.hpp"
 #include "util/v128.hpp"
 #include "util/simd.hpp"
+#include <algorithm>
 #include <charconv>
 #include <zlib.h>
 
@@ -132,6 +133,9 @@ static u8* get_jit_memory()
 // Allocation counters (1G code, 1G data subranges)
 static atomic_t<u64> s_code_pos{0}, s_data_pos{0};
 
+// Memory allocated by the LLVM linker outside of jit_runtime (PPU modules)
+static atomic_t<u64> s_llvm_code_size{0}, s_llvm_data_size{0};
+
 // Snapshot of code generated before main()
 static std::vector<u8> s_code_init, s_data_init;
 
@@ -274,6 +278,80 @@ void jit_runtime::initialize()
 	std::memcpy(s_data_init.data(), alloc(0, 0, false), s_data_init.size());
 }
 
+u64 jit_runtime::get_code_size() noexcept
+{
+	return s_code_pos & 0xffff'ffff;
+}
+
+u64 jit_runtime::get_data_size() noexcept
+{
+	return s_data_pos & 0xffff'ffff;
+}
+
+jit_compile_stats::jit_compile_stats() noexcept
+	: m_code_size0(jit_runtime::get_code_size())
+	, m_data_size0(jit_runtime::get_data_size())
+	, m_llvm_code_size0(s_llvm_code_size)
+	, m_llvm_data_size0(s_llvm_data_size)
+	, m_start(std::chrono::steady_clock::now())
+{
+}
+
+void jit_compile_stats::add(std::chrono::steady_clock::duration time, u64 func_count)
+{
+	const u64 us = std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_times.push_back(us);
+		m_funcs += func_count;
+	}
+
+	if (const auto total = s_total.load(); total && total != this)
+	{
+		total->add(time, func_count);
+	}
+}
+
+std::string jit_compile_stats::summary(u32 thread_count)
+{
+	std::lock_guard lock(m_mutex);
+
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+
+	std::string result = fmt::format("%u functions (%u units) in %.3fs with %u threads (%.1f functions/s)", m_funcs, m_times.size(), elapsed, thread_count, m_funcs / std::max(elapsed, 0.001));
+
+	if (!m_times.empty())
+	{
+		std::sort(m_times.begin(), m_times.end());
+
+		const auto percentile = [&](u64 p)
+		{
+			return m_times[(m_times.size() - 1) * p / 100] / 1000.;
+		};
+
+		fmt::append(result, ", unit time: p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms", percentile(50), percentile(90), percentile(99), m_times.back() / 1000.);
+	}
+
+	if (const u64 code = jit_runtime::get_code_size() - m_code_size0, data = jit_runtime::get_data_size() - m_data_size0; code || data)
+	{
+		fmt::append(result, ", JIT code: %u KiB, data: %u KiB", code / 1024, data / 1024);
+	}
+
+	// PPU modules are linked by MemoryManager1 and don't use jit_runtime
+	if (const u64 code = s_llvm_code_size - m_llvm_code_size0, data = s_llvm_data_size - m_llvm_data_size0; code || data)
+	{
+		fmt::append(result, ", LLVM code: %u KiB, data: %u KiB", code / 1024, data / 1024);
+	}
+
+	if (const u64 peak = utils::get_peak_memory_usage())
+	{
+		fmt::append(result, ", peak memory: %u MiB", peak / (1024 * 1024));
+	}
+
+	return result;
+}
+
 void jit_runtime::finalize() noexcept
 {
 #ifdef __APPLE__
@@ -1075,11 +1153,13 @@ struct MemoryManager1 : llvm::RTDyldMemoryManager
 
 	u8* allocateCodeSection(uptr size, uint align, uint /*sec_id*/, llvm::StringRef /*sec_name*/) override
 	{
+		s_llvm_code_size += size;
 		return allocate(code_ptr, size, align, utils::protection::wx);
 	}
 
 	u8* allocateDataSection(uptr size, uint align, uint /*sec_id*/, llvm::StringRef /*sec_name*/, bool /*is_ro*/) override
 	{
+		s_llvm_data_size += size;
 		return allocate(data_ptr, size, align, utils::protection::rw);
 	}
 
@@ -1298,6 +1378,216 @@ public:
 	}
 };
 
+// Memory buffer referencing an object in the mapped pack file
+class MemoryBufferPacked final : public llvm::MemoryBuffer
+{
+	std::shared_ptr<fs::file_map> m_map;
+
+public:
+	MemoryBufferPacked(std::shared_ptr<fs::file_map> map, const u8* ptr, u64 size)
+		: m_map(std::move(map))
+	{
+		init(reinterpret_cast<const char*>(ptr), reinterpret_cast<const char*>(ptr + size), false);
+	}
+
+	BufferKind getBufferKind() const override
+	{
+		return MemoryBuffer_MMap;
+	}
+};
+
+namespace
+{
+	struct object_pack_header
+	{
+		u64 magic;
+		u32 version;
+		u32 count;
+		u64 index_size;
+	};
+
+	struct object_pack_entry
+	{
+		u64 offset;
+		u64 size;
+		u32 name_size;
+		u32 reserved;
+	};
+
+	constexpr u32 c_object_pack_version = 1;
+}
+
+jit_object_pack::jit_object_pack(const std::string& path)
+{
+	fs::file file(path);
+
+	if (!file)
+	{
+		return;
+	}
+
+	auto map = std::make_shared<fs::file_map>(file);
+
+	if (!*map)
+	{
+		jit_log.error("ObjectPack: Failed to map %s (%s)", path, fs::g_tls_error);
+		return;
+	}
+
+	const u8* const data = map->data();
+	const u64 fsize = map->size();
+
+	object_pack_header header{};
+
+	if (fsize < sizeof(header))
+	{
+		jit_log.error("ObjectPack: Truncated file: %s", path);
+		return;
+	}
+
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.magic != "RPCS3OBJ"_u64 || header.version != c_object_pack_version || header.index_size > fsize - sizeof(header))
+	{
+		jit_log.error("ObjectPack: Invalid header: %s", path);
+		return;
+	}
+
+	u64 pos = sizeof(header);
+	const u64 index_end = pos + header.index_size;
+
+	for (u32 i = 0; i < header.count; i++)
+	{
+		object_pack_entry entry{};
+
+		if (index_end - pos < sizeof(entry))
+		{
+			break;
+		}
+
+		std::memcpy(&entry, data + pos, sizeof(entry));
+		pos += sizeof(entry);
+
+		if (index_end - pos < entry.name_size || entry.offset < index_end || entry.offset > fsize || fsize - entry.offset < entry.size || !entry.size)
+		{
+			break;
+		}
+
+		m_index.emplace(std::string(reinterpret_cast<const char*>(data + pos), entry.name_size), std::make_pair(entry.offset, entry.size));
+		pos += entry.name_size;
+	}
+
+	if (m_index.size() != header.count)
+	{
+		jit_log.error("ObjectPack: Damaged index (%u/%u entries): %s", m_index.size(), header.count, path);
+		m_index.clear();
+		return;
+	}
+
+	m_map = std::move(map);
+}
+
+std::pair<const u8*, u64> jit_object_pack::get(const std::string& name) const
+{
+	if (const auto found = m_index.find(name); found != m_index.end() && m_map)
+	{
+		return {m_map->data() + found->second.first, found->second.second};
+	}
+
+	return {nullptr, 0};
+}
+
+bool jit_object_pack::write(const std::string& path, const std::vector<std::string>& names, jit_object_pack&& prev, const std::string& dir)
+{
+	// Object data (either mapped or owned)
+	std::vector<std::pair<const u8*, u64>> objects;
+	std::vector<std::unique_ptr<llvm::MemoryBuffer>> loaded;
+	objects.reserve(names.size());
+
+	u64 index_size = 0;
+
+	for (const std::string& name : names)
+	{
+		auto obj = prev.get(name);
+
+		if (!obj.first)
+		{
+			// Import loose object file
+			auto& buf = loaded.emplace_back(ObjectCache::load(dir + name));
+
+			if (!buf)
+			{
+				jit_log.error("ObjectPack: Failed to import %s%s", dir, name);
+				return false;
+			}
+
+			obj = {reinterpret_cast<const u8*>(buf->getBufferStart()), buf->getBufferSize()};
+		}
+
+		objects.emplace_back(obj);
+		index_size += sizeof(object_pack_entry) + name.size();
+	}
+
+	object_pack_header header{};
+	header.magic = "RPCS3OBJ"_u64;
+	header.version = c_object_pack_version;
+	header.count = ::size32(names);
+	header.index_size = index_size;
+
+	std::vector<u8> index;
+	index.reserve(sizeof(header) + index_size);
+	index.insert(index.end(), reinterpret_cast<const u8*>(&header), reinterpret_cast<const u8*>(&header + 1));
+
+	// Objects are aligned to 16 bytes
+	u64 offset = utils::align<u64>(sizeof(header) + index_size, 16);
+
+	for (usz i = 0; i < names.size(); i++)
+	{
+		object_pack_entry entry{};
+		entry.offset = offset;
+		entry.size = objects[i].second;
+		entry.name_size = ::size32(names[i]);
+		index.insert(index.end(), reinterpret_cast<const u8*>(&entry), reinterpret_cast<const u8*>(&entry + 1));
+		index.insert(index.end(), names[i].begin(), names[i].end());
+		offset = utils::align<u64>(offset + entry.size, 16);
+	}
+
+	fs::pending_file file(path);
+
+	if (!file.file)
+	{
+		jit_log.error("ObjectPack: Failed to create %s (%s)", path, fs::g_tls_error);
+		return false;
+	}
+
+	file.file.write(index);
+
+	u64 pos = index.size();
+
+	for (const auto& [ptr, size] : objects)
+	{
+		static constexpr u8 s_zero[16]{};
+
+		// Pad to the next object offset
+		file.file.write(s_zero, utils::align<u64>(pos, 16) - pos);
+		pos = utils::align<u64>(pos, 16);
+		file.file.write(ptr, size);
+		pos += size;
+	}
+
+	// Unmap the previous file before replacing it
+	prev = jit_object_pack{};
+
+	if (!file.commit())
+	{
+		jit_log.error("ObjectPack: Failed to commit %s (%s)", path, fs::g_tls_error);
+		return false;
+	}
+
+	jit_log.success("ObjectPack: Written %u objects to %s", names.size(), path);
+	return true;
+}
+
 std::string jit_compiler::cpu(const std::string& _cpu)
 {
 	std::string m_cpu = _cpu;
@@ -1469,6 +1759,31 @@ void jit_compiler::add(const std::string& path)
 	}
 }
 
+bool jit_compiler::add(const jit_object_pack& pack, const std::string& name)
+{
+	const auto [ptr, size] = pack.get(name);
+
+	if (!ptr)
+	{
+		return false;
+	}
+
+	// The buffer keeps the mapping alive
+	auto buf = std::make_unique<MemoryBufferPacked>(pack.get_map(), ptr, size);
+
+	auto object_file = llvm::object::ObjectFile::createObjectFile(buf->getMemBufferRef());
+
+	if (!object_file)
+	{
+		llvm::consumeError(object_file.takeError());
+		jit_log.error("ObjectPack: Adding failed: %s", name);
+		return false;
+	}
+
+	m_engine->addObjectFile(llvm::object::OwningBinary<llvm::object::ObjectFile>(std::move(*object_file), std::move(buf)));
+	return true;
+}
+
 bool jit_compiler::check(const std::string& path)
 {
 	if (auto cache = ObjectCache::load(path))
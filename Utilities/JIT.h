@@ -37,11 +37,15 @@
 #endif
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <util/v128.hpp>
 
 #if defined(ARCH_X64)
@@ -97,6 +101,41 @@ struct jit_runtime final : jit_runtime_base
 
 	// Deallocate all memory
 	static void finalize() noexcept;
+
+	// Get amount of allocated code/data memory
+	static u64 get_code_size() noexcept;
+	static u64 get_data_size() noexcept;
+};
+
+// Compilation throughput statistics (thread-safe)
+class jit_compile_stats
+{
+	std::mutex m_mutex;
+	std::vector<u64> m_times; // Compilation time of each unit (us)
+	u64 m_funcs = 0;
+	u64 m_code_size0;
+	u64 m_data_size0;
+	u64 m_llvm_code_size0;
+	u64 m_llvm_data_size0;
+	std::chrono::steady_clock::time_point m_start;
+
+	// Instance receiving all records in addition (--jit-bench)
+	static inline std::atomic<jit_compile_stats*> s_total{};
+
+public:
+	jit_compile_stats() noexcept;
+
+	// Record compilation of a unit (function or module)
+	void add(std::chrono::steady_clock::duration time, u64 func_count = 1);
+
+	// Set instance receiving all records in addition (nullptr to reset)
+	static void set_total(jit_compile_stats* total) noexcept
+	{
+		s_total = total;
+	}
+
+	// Format summary: throughput, unit time percentiles, JIT and LLVM linker memory growth, peak memory usage
+	std::string summary(u32 thread_count);
 };
 
 namespace asmjit
@@ -496,6 +535,53 @@ namespace llvm
 	class Module;
 }
 
+namespace fs
+{
+	class file_map;
+}
+
+// Packed object cache: index followed by concatenated uncompressed object files, loaded via memory mapping
+class jit_object_pack final
+{
+	// Mapped file (shared with loaded objects)
+	std::shared_ptr<fs::file_map> m_map{};
+
+	// Object name -> (offset, size)
+	std::unordered_map<std::string, std::pair<u64, u64>> m_index{};
+
+public:
+	jit_object_pack() = default;
+
+	// Open and validate existing pack file
+	explicit jit_object_pack(const std::string& path);
+
+	explicit operator bool() const
+	{
+		return m_map.operator bool();
+	}
+
+	usz size() const
+	{
+		return m_index.size();
+	}
+
+	bool contains(const std::string& name) const
+	{
+		return m_index.contains(name);
+	}
+
+	// Get object data (nullptr if not found)
+	std::pair<const u8*, u64> get(const std::string& name) const;
+
+	const std::shared_ptr<fs::file_map>& get_map() const
+	{
+		return m_map;
+	}
+
+	// Write new pack file containing specified objects, taken from the previous pack (released) or loose object files in the directory
+	static bool write(const std::string& path, const std::vector<std::string>& names, jit_object_pack&& prev, const std::string& dir);
+};
+
 // Temporary compiler interface
 class jit_compiler final
 {
@@ -532,6 +618,9 @@ public:
 	// Add object (path to obj file)
 	void add(const std::string& path);
 
+	// Add object from the pack without copying
+	bool add(const jit_object_pack& pack, const std::string& name);
+
 	// Update global mapping for a single value
 	void update_global_mapping(const std::string& name, u64 addr);
 
@@ -2002,6 +2002,11 @@ void thread_base::initialize(void (*error_cb)())
 		return thread_ctrl::get_name_cached();
 	};
 
+	logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+	{
+		prefix.set("%s", thread_ctrl::get_name_cached());
+	});
+
 	atomic_wait_engine::set_wait_callback([](const void*, u64 attempts, u64 stamp0) -> bool
 	{
 		if (attempts == umax)
@@ -2111,6 +2116,11 @@ u64 thread_base::finalize(thread_state result_state) noexcept
 		return thread_ctrl::get_name_cached();
 	};
 
+	logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+	{
+		prefix.set("%s", thread_ctrl::get_name_cached());
+	});
+
 	sig_log.notice("Thread time: %fs (%fGc); Faults: %u [rsx:%u, spu:%u]; [soft:%u hard:%u]; Switches:[vol:%u unvol:%u]; Wait:[%.3fs, spur:%u]",
 		time / 1000000000.,
 		cycles / 1000000000.,
@@ -2151,6 +2161,7 @@ thread_base::native_entry thread_base::finalize(u64 _self) noexcept
 	const auto fake_self = reinterpret_cast<thread_base*>(_self);
 
 	g_tls_log_prefix = []() -> std::string { return {}; };
+	logs::set_tls_raw_prefix([](logs::raw_prefix& prefix) { prefix.set(""); });
 	thread_ctrl::g_tls_this_thread = fake_self;
 
 	if (!_self)
@@ -2431,13 +2442,14 @@ void thread_ctrl::wait_for_accurate(u64 usec)
 	}
 }
 
-std::string thread_ctrl::get_name_cached()
+const std::string& thread_ctrl::get_name_cached()
 {
 	auto _this = thread_ctrl::g_tls_this_thread;
 
 	if (!_this)
 	{
-		return {};
+		static const std::string s_empty;
+		return s_empty;
 	}
 
 	static thread_local shared_ptr<std::string> name_cache;
@@ -203,8 +203,8 @@ class thread_ctrl final
 
 	friend class thread_base;
 
-	// Optimized get_name() for logging
-	static std::string get_name_cached();
+	// Optimized get_name() for logging (reference is valid until the thread name changes)
+	static const std::string& get_name_cached();
 
 public:
 	// Get current thread name
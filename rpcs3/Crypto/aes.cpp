@@ -883,6 +883,39 @@ int aes_crypt_ctr( aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * AES-CTR in-place block decryption
+ */
+int aes_crypt_ctr_blocks( aes_context *ctx,
+                       size_t blocks,
+                       unsigned char nonce_counter[16],
+                       unsigned char *data )
+{
+    unsigned char stream_block[16];
+    int i;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    if( aesni_supports( POLARSSL_AESNI_AES ) )
+        return( aesni_crypt_ctr_blocks( ctx, blocks, nonce_counter, data ) );
+#endif
+
+    while( blocks-- )
+    {
+        aes_crypt_ecb( ctx, AES_ENCRYPT, nonce_counter, stream_block );
+
+        for( i = 16; i > 0; i-- )
+            if( ++nonce_counter[i - 1] != 0 )
+                break;
+
+        for( i = 0; i < 16; i++ )
+            data[i] ^= stream_block[i];
+
+        data += 16;
+    }
+
+    return( 0 );
+}
+
 /* AES-CMAC */
 
 unsigned char const_Rb[16] = {
@@ -172,6 +172,23 @@ int aes_crypt_ctr( aes_context *ctx,
                        const unsigned char *input,
                        unsigned char *output );
 
+/**
+ * \brief          AES-CTR in-place decryption of whole blocks
+ *
+ *                 Uses AES-NI with 8 blocks in flight when available.
+ *
+ * \param ctx           AES context (initialized with aes_setkey_enc())
+ * \param blocks        The number of 16-byte blocks
+ * \param nonce_counter The 128-bit big-endian counter, updated for resuming
+ * \param data          The data to process
+ *
+ * \return         0 if successful
+ */
+int aes_crypt_ctr_blocks( aes_context *ctx,
+                       size_t blocks,
+                       unsigned char nonce_counter[16],
+                       unsigned char *data );
+
 void aes_cmac(aes_context *ctx, int length, unsigned char *input, unsigned char *output);
 
 #ifdef __cplusplus
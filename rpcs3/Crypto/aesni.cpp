@@ -35,6 +35,10 @@
 #if defined(_MSC_VER) && defined(_M_X64)
 #define POLARSSL_HAVE_MSVC_X64_INTRINSICS
 #include <intrin.h>
+#define AESNI_CTR_FUNC
+#else
+#include <immintrin.h>
+#define AESNI_CTR_FUNC __attribute__((__target__("aes,ssse3")))
 #endif
 
 /*
@@ -131,6 +135,62 @@ int aesni_crypt_ecb( aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * AES-NI AES-CTR in-place block decryption, 8 blocks in flight
+ */
+AESNI_CTR_FUNC int aesni_crypt_ctr_blocks( aes_context *ctx,
+                                           size_t blocks,
+                                           unsigned char nonce_counter[16],
+                                           unsigned char *data )
+{
+    const __m128i* rk = (const __m128i*)ctx->rk;
+    const __m128i bswap = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+
+    // Keep the big-endian counter as native 128-bit value
+    const __m128i ctr = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)nonce_counter ), bswap );
+    unsigned long long lo = (unsigned long long)_mm_cvtsi128_si64( ctr );
+    unsigned long long hi = (unsigned long long)_mm_cvtsi128_si64( _mm_unpackhi_epi64( ctr, ctr ) );
+
+    while( blocks )
+    {
+        const size_t n = blocks < 8 ? blocks : 8;
+        __m128i b[8];
+        size_t i;
+        int r;
+
+        for( i = 0; i < n; i++ )
+        {
+            b[i] = _mm_xor_si128( _mm_shuffle_epi8( _mm_set_epi64x( (long long)hi, (long long)lo ), bswap ), _mm_loadu_si128( rk ) );
+
+            if( ++lo == 0 )
+                hi++;
+        }
+
+        for( r = 1; r < ctx->nr; r++ )
+        {
+            const __m128i k = _mm_loadu_si128( rk + r );
+
+            for( i = 0; i < n; i++ )
+                b[i] = _mm_aesenc_si128( b[i], k );
+        }
+
+        const __m128i k = _mm_loadu_si128( rk + ctx->nr );
+
+        for( i = 0; i < n; i++ )
+        {
+            __m128i* p = (__m128i*)( data + i * 16 );
+            _mm_storeu_si128( p, _mm_xor_si128( _mm_loadu_si128( p ), _mm_aesenclast_si128( b[i], k ) ) );
+        }
+
+        data += n * 16;
+        blocks -= n;
+    }
+
+    _mm_storeu_si128( (__m128i*)nonce_counter, _mm_shuffle_epi8( _mm_set_epi64x( (long long)hi, (long long)lo ), bswap ) );
+
+    return( 0 );
+}
+
 #if defined(POLARSSL_HAVE_MSVC_X64_INTRINSICS)
 static inline void clmul256( __m128i a, __m128i b, __m128i* r0, __m128i* r1 )
 {
@@ -75,6 +75,21 @@ void aesni_gcm_mult( unsigned char c[16],
                      const unsigned char a[16],
                      const unsigned char b[16] );
 
+/**
+ * \brief          AES-NI AES-CTR en(de)cryption of whole blocks
+ *
+ * \param ctx      AES context (encryption round keys)
+ * \param blocks   Number of 16-byte blocks to process
+ * \param nonce_counter  128-bit big-endian counter, incremented per block
+ * \param data     Buffer processed in place
+ *
+ * \return         0 on success (cannot fail)
+ */
+int aesni_crypt_ctr_blocks( aes_context *ctx,
+                            size_t blocks,
+                            unsigned char nonce_counter[16],
+                            unsigned char *data );
+
 /**
  * \brief           Compute decryption round keys from encryption round keys
  *
@@ -9,6 +9,10 @@
 #include "Emu/VFS.h"
 #include "unpkg.h"
 #include "Loader/PSF.h"
+#include "Utilities/Thread.h"
+
+#include <deque>
+#include <condition_variable>
 
 LOG_CHANNEL(pkg_log, "PKG");
 
@@ -688,6 +692,283 @@ package_error package_reader::check_target_app_version() const
 
 fs::file DecryptEDAT(const fs::file& input, const std::string& input_file_name, int mode, u8 *custom_klic, bool verbose = false);
 
+struct package_reader::install_entry
+{
+	std::string name;
+	std::string path;
+	const uchar* key{};
+	u64 offset{};
+	u64 size{};
+	bool is_buffered{};
+	bool did_overwrite{};
+
+	// Bytes which have not been written yet
+	atomic_t<u64> remaining{};
+
+	// Protects the file position
+	std::mutex mutex;
+	fs::file out;
+	bool failed = false;
+};
+
+struct package_reader::install_worker
+{
+	install_context* _this;
+
+	void operator()() const;
+};
+
+// Reader (caller thread) feeding a pool of decryption workers, which write independent entries in parallel
+struct package_reader::install_context
+{
+	struct chunk
+	{
+		install_entry* entry;
+		u64 pos; // Position within entry
+		u64 size;
+		std::unique_ptr<u128[]> buf;
+	};
+
+	package_reader& reader;
+	atomic_t<double>& sync;
+
+	std::deque<install_entry> entries;
+	atomic_t<usz> num_failures{0};
+	atomic_t<bool> cancelled{false};
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<chunk> jobs;
+	std::vector<std::unique_ptr<u128[]>> free_bufs;
+	bool finished = false;
+
+	install_context(package_reader& reader, atomic_t<double>& sync)
+		: reader(reader)
+		, sync(sync)
+	{
+	}
+
+	// Account written (or skipped) data of the entry and finalize it
+	void complete(install_entry& entry, u64 size)
+	{
+		if (entry.remaining.sub_fetch(size) != 0)
+		{
+			return;
+		}
+
+		std::lock_guard lock(entry.mutex);
+
+		if (entry.failed || cancelled)
+		{
+			entry.out.close();
+			return;
+		}
+
+		if (entry.is_buffered)
+		{
+			entry.out = DecryptEDAT(entry.out, entry.name, 1, reinterpret_cast<u8*>(&reader.m_header.klicensee), true);
+
+			if (!entry.out || !fs::write_file(entry.path, fs::rewrite, static_cast<fs::container_stream<std::vector<u8>>*>(entry.out.release().get())->obj))
+			{
+				num_failures++;
+				pkg_log.error("Failed to create file %s", entry.path);
+				return;
+			}
+		}
+
+		entry.out.close();
+
+		if (entry.did_overwrite)
+		{
+			pkg_log.warning("Overwritten file %s", entry.path);
+		}
+		else
+		{
+			pkg_log.notice("Created file %s", entry.path);
+		}
+	}
+
+	// Open output file (entry mutex must be locked)
+	bool open(install_entry& entry)
+	{
+		if (!entry.out && !entry.failed)
+		{
+			entry.out = entry.is_buffered ? fs::make_stream<std::vector<u8>>() : fs::file{entry.path, fs::rewrite};
+
+			if (!entry.out)
+			{
+				entry.failed = true;
+				num_failures++;
+				pkg_log.error("Failed to create file %s", entry.path);
+			}
+		}
+
+		return !entry.failed;
+	}
+
+	// Returns false if cancelled
+	bool run(bool can_cancel)
+	{
+		const u32 thread_count = std::clamp<u32>(rpcs3::utils::get_max_threads(), 1, 8);
+
+		for (u32 i = 0; i < thread_count + 2; i++)
+		{
+			free_bufs.emplace_back(new u128[reader.BUF_SIZE / sizeof(u128)]);
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+
+		u64 total_size = 0;
+		{
+			named_thread_group workers("PKG Installer ", thread_count, install_worker{this});
+
+			for (install_entry& entry : entries)
+			{
+				if (!entry.size)
+				{
+					// Create empty file
+					{
+						std::lock_guard lock(entry.mutex);
+						open(entry);
+					}
+
+					complete(entry, 0);
+					continue;
+				}
+
+				for (u64 pos = 0; pos < entry.size && !cancelled; pos += reader.BUF_SIZE)
+				{
+					const u64 block_size = std::min<u64>(reader.BUF_SIZE, entry.size - pos);
+
+					std::unique_ptr<u128[]> buf;
+					{
+						// Limit the amount of data in flight
+						std::unique_lock lock(mutex);
+						cv.wait(lock, [&]() { return !free_bufs.empty(); });
+						buf = std::move(free_bufs.back());
+						free_bufs.pop_back();
+					}
+
+					reader.archive_seek(reader.m_header.data_offset + entry.offset + pos);
+
+					if (reader.archive_read(buf.get(), block_size) != block_size)
+					{
+						{
+							std::lock_guard lock(entry.mutex);
+
+							if (!entry.failed)
+							{
+								entry.failed = true;
+								num_failures++;
+								pkg_log.error("Failed to extract file %s", entry.path);
+							}
+						}
+
+						{
+							std::lock_guard lock(mutex);
+							free_bufs.emplace_back(std::move(buf));
+						}
+
+						// Skip the rest of the entry
+						complete(entry, entry.size - pos);
+						break;
+					}
+
+					total_size += block_size;
+
+					{
+						std::lock_guard lock(mutex);
+						jobs.push_back(chunk{&entry, pos, block_size, std::move(buf)});
+						cv.notify_all();
+					}
+
+					if (sync < 0.)
+					{
+						if (can_cancel)
+						{
+							cancelled = true;
+							break;
+						}
+
+						// Cannot cancel the installation
+						sync += 1.;
+					}
+				}
+
+				if (cancelled)
+				{
+					break;
+				}
+			}
+
+			std::lock_guard lock(mutex);
+			finished = true;
+			cv.notify_all();
+		}
+
+		// Close remaining files
+		entries.clear();
+
+		if (cancelled)
+		{
+			return false;
+		}
+
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		pkg_log.notice("Extracted %.2f MiB of package data in %.3fs (%.2f MiB/s, %u threads)", total_size / 1048576., elapsed, total_size / 1048576. / std::max(elapsed, 0.001), thread_count);
+		return true;
+	}
+};
+
+void package_reader::install_worker::operator()() const
+{
+	while (true)
+	{
+		install_context::chunk job;
+		{
+			std::unique_lock lock(_this->mutex);
+			_this->cv.wait(lock, [&]() { return _this->finished || !_this->jobs.empty(); });
+
+			if (_this->jobs.empty())
+			{
+				return;
+			}
+
+			job = std::move(_this->jobs.front());
+			_this->jobs.pop_front();
+		}
+
+		install_entry& entry = *job.entry;
+
+		if (!_this->cancelled)
+		{
+			_this->reader.decrypt_chunk(entry.offset + job.pos, job.size, entry.key, job.buf.get());
+
+			std::lock_guard lock(entry.mutex);
+
+			if (_this->open(entry))
+			{
+				if (entry.out.seek(job.pos) != job.pos || entry.out.write(job.buf.get(), job.size) != job.size)
+				{
+					entry.failed = true;
+					_this->num_failures++;
+					pkg_log.error("Failed to write file %s", entry.path);
+				}
+			}
+		}
+
+		_this->sync += (job.size + 0.0) / _this->reader.m_header.data_size;
+
+		{
+			std::lock_guard lock(_this->mutex);
+			_this->free_bufs.emplace_back(std::move(job.buf));
+			_this->cv.notify_all();
+		}
+
+		_this->complete(entry, job.size);
+	}
+}
+
 bool package_reader::extract_data(atomic_t<double>& sync)
 {
 	if (!m_is_valid)
@@ -749,6 +1030,9 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 
 	std::memcpy(entries.data(), m_buf.get(), entries.size() * sizeof(PKGEntry));
 
+	// File entries are extracted after the directory structure is created
+	install_context ctx(*this, sync);
+
 	for (const auto& entry : entries)
 	{
 		if (entry.name_size > 256)
@@ -794,82 +1078,20 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 				break;
 			}
 
-			const bool is_buffered = entry_type == PKG_FILE_ENTRY_SDAT;
-
 			if (entry_type == PKG_FILE_ENTRY_NPDRMEDAT)
 			{
 				pkg_log.todo("NPDRM EDAT!");
 			}
 
-			if (fs::file out = is_buffered ? fs::make_stream<std::vector<u8>>() : fs::file{ path, fs::rewrite })
-			{
-				bool extract_success = true;
-				for (u64 pos = 0; pos < entry.file_size; pos += BUF_SIZE)
-				{
-					const u64 block_size = std::min<u64>(BUF_SIZE, entry.file_size - pos);
-
-					if (decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data()) != block_size)
-					{
-						extract_success = false;
-						pkg_log.error("Failed to extract file %s", path);
-						break;
-					}
-
-					if (out.write(m_buf.get(), block_size) != block_size)
-					{
-						extract_success = false;
-						pkg_log.error("Failed to write file %s", path);
-						break;
-					}
-
-					if (sync.fetch_add((block_size + 0.0) / m_header.data_size) < 0.)
-					{
-						if (was_null)
-						{
-							pkg_log.error("Package installation cancelled: %s", dir);
-							out.close();
-							fs::remove_all(dir, true);
-							return false;
-						}
-
-						// Cannot cancel the installation
-						sync += 1.;
-					}
-				}
-
-				if (is_buffered)
-				{
-					out = DecryptEDAT(out, name, 1, reinterpret_cast<u8*>(&m_header.klicensee), true);
-					if (!out || !fs::write_file(path, fs::rewrite, static_cast<fs::container_stream<std::vector<u8>>*>(out.release().get())->obj))
-					{
-						num_failures++;
-						pkg_log.error("Failed to create file %s", path);
-						break;
-					}
-				}
-
-				if (extract_success)
-				{
-					if (did_overwrite)
-					{
-						pkg_log.warning("Overwritten file %s", path);
-					}
-					else
-					{
-						pkg_log.notice("Created file %s", path);
-					}
-				}
-				else
-				{
-					num_failures++;
-				}
-			}
-			else
-			{
-				num_failures++;
-				pkg_log.error("Failed to create file %s", path);
-			}
-
+			auto& file = ctx.entries.emplace_back();
+			file.name = name;
+			file.path = path;
+			file.key = is_psp ? PKG_AES_KEY2 : m_dec_key.data();
+			file.offset = entry.file_offset;
+			file.size = entry.file_size;
+			file.remaining = entry.file_size;
+			file.is_buffered = entry_type == PKG_FILE_ENTRY_SDAT;
+			file.did_overwrite = did_overwrite;
 			break;
 		}
 
@@ -901,6 +1123,15 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 		}
 	}
 
+	if (!ctx.run(was_null))
+	{
+		pkg_log.error("Package installation cancelled: %s", dir);
+		fs::remove_all(dir, true);
+		return false;
+	}
+
+	num_failures += ctx.num_failures;
+
 	if (num_failures == 0)
 	{
 		pkg_log.success("Package successfully installed to %s", dir);
@@ -942,8 +1173,16 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 	// Read the data and set available size
 	const u64 read = archive_read(m_buf.get(), size);
 
+	decrypt_chunk(offset, read, key, m_buf.get());
+
+	// Return the amount of data written in buf
+	return read;
+}
+
+void package_reader::decrypt_chunk(u64 offset, u64 size, const uchar* key, u128* buf) const
+{
 	// Get block count
-	const u64 blocks = (read + 15) / 16;
+	const u64 blocks = (size + 15) / 16;
 
 	if (m_header.pkg_type == PKG_RELEASE_TYPE_DEBUG)
 	{
@@ -969,7 +1208,7 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 
 			sha1(reinterpret_cast<const u8*>(input), sizeof(input), hash.data);
 
-			m_buf[i] ^= hash._v128;
+			buf[i] ^= hash._v128;
 		}
 	}
 	else if (m_header.pkg_type == PKG_RELEASE_TYPE_RELEASE)
@@ -982,21 +1221,11 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 		// Initialize stream cipher for start position
 		be_t<u128> input = m_header.klicensee.value() + offset / 16;
 
-		// Increment stream position for every block
-		for (u64 i = 0; i < blocks; i++, input++)
-		{
-			u128 key;
-
-			aes_crypt_ecb(&ctx, AES_ENCRYPT, reinterpret_cast<const u8*>(&input), reinterpret_cast<u8*>(&key));
-
-			m_buf[i] ^= key;
-		}
+		// Decrypt with wide keystream (the counter is incremented for every block)
+		aes_crypt_ctr_blocks(&ctx, blocks, reinterpret_cast<uchar*>(&input), reinterpret_cast<uchar*>(buf));
 	}
 	else
 	{
 		pkg_log.error("Unknown release type (0x%x)", m_header.pkg_type);
 	}
-
-	// Return the amount of data written in buf
-	return read;
-};
+}
@@ -320,6 +320,12 @@ private:
 	void archive_seek(const s64 new_offset, const fs::seek_mode damode = fs::seek_set);
 	u64 archive_read(void* data_ptr, const u64 num_bytes);
 	u64 decrypt(u64 offset, u64 size, const uchar* key);
+	void decrypt_chunk(u64 offset, u64 size, const uchar* key, u128* buf) const;
+
+	// Multi-threaded extraction of file entries
+	struct install_entry;
+	struct install_context;
+	struct install_worker;
 
 	const usz BUF_SIZE = 8192 * 1024; // 8 MB
 
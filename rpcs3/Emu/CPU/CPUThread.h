@@ -68,6 +68,9 @@ public:
 	// Public thread state
 	atomic_bs_t<cpu_flag> state{cpu_flag::stop + cpu_flag::wait};
 
+	// Position in the lv2 scheduler timeout queue (umax if not queued, protected by lv2_obj::g_mutex)
+	u32 lv2_timeout_index = umax;
+
 	// Process thread state, return true if the checker must return
 	bool check_state() noexcept;
 
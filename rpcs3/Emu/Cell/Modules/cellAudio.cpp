@@ -5,6 +5,7 @@
 #include "Emu/Cell/lv2/sys_process.h"
 #include "Emu/Cell/lv2/sys_event.h"
 #include "cellAudio.h"
+#include "util/simd.hpp"
 
 #include <cmath>
 
@@ -1035,6 +1036,115 @@ audio_port* cell_audio_thread::open_port()
 	return nullptr;
 }
 
+// Mix one block of a port into the output buffer (Ramp: use per-frame volume)
+template <u32 out_channels, u32 in_channels, AudioChannelCnt downmix, bool Ramp>
+static void mix_port(float* out_buffer, const be_t<f32>* buf, float m, const float* volumes)
+{
+	static constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
+
+	const v128 vol = gv_bcstfs(m);
+
+	// Volume of two consecutive stereo frames
+	const auto pair_volume = [volumes](u32 frame)
+	{
+		v128 r;
+		r._f[0] = r._f[1] = volumes[frame];
+		r._f[2] = r._f[3] = volumes[frame + 1];
+		return r;
+	};
+
+	if constexpr (in_channels == 2 && out_channels == 2)
+	{
+		// Two frames per vector
+		for (u32 frame = 0; frame < AUDIO_BUFFER_SAMPLES; frame += 2)
+		{
+			v128 frame_vol = vol;
+
+			if constexpr (Ramp)
+			{
+				frame_vol = pair_volume(frame);
+			}
+
+			const v128 in = gv_mulfs(gv_rev32(v128::loadu(buf + frame * 2)), frame_vol);
+			v128::storeu(gv_addfs(v128::loadu(out_buffer + frame * 2), in), out_buffer + frame * 2);
+		}
+	}
+	else if constexpr (in_channels == 2)
+	{
+		for (u32 frame = 0; frame < AUDIO_BUFFER_SAMPLES; frame += 2)
+		{
+			v128 frame_vol = vol;
+
+			if constexpr (Ramp)
+			{
+				frame_vol = pair_volume(frame);
+			}
+
+			const v128 in = gv_mulfs(gv_rev32(v128::loadu(buf + frame * 2)), frame_vol);
+
+			float* out = out_buffer + frame * out_channels;
+			out[0] += in._f[0];
+			out[1] += in._f[1];
+			out[out_channels + 0] += in._f[2];
+			out[out_channels + 1] += in._f[3];
+		}
+	}
+	else
+	{
+		for (u32 frame = 0; frame < AUDIO_BUFFER_SAMPLES; frame++)
+		{
+			const v128 frame_vol = Ramp ? gv_bcstfs(volumes[frame]) : vol;
+
+			// left, right, center, low_freq
+			const v128 front = gv_mulfs(gv_rev32(v128::loadu(buf + frame * 8)), frame_vol);
+
+			// side_left, side_right, rear_left, rear_right
+			const v128 back = gv_mulfs(gv_rev32(v128::loadu(buf + frame * 8 + 4)), frame_vol);
+
+			float* out = out_buffer + frame * out_channels;
+
+			if constexpr (downmix == AudioChannelCnt::STEREO)
+			{
+				// Don't mix in the lfe as per dolby specification and based on documentation
+				const v128 mid = gv_bcstfs(front._f[2] * 0.5f);
+				const v128 half = gv_bcstfs(0.5f);
+				const v128 mixed = gv_addfs(gv_addfs(gv_addfs(gv_mulfs(front, gv_bcstfs(minus_3db)), mid), gv_mulfs(back, half)), gv_mulfs(gv_shuffle_right<8>(back), half));
+				out[0] += mixed._f[0];
+				out[1] += mixed._f[1];
+			}
+			else if constexpr (out_channels == 2)
+			{
+				out[0] += front._f[0];
+				out[1] += front._f[1];
+			}
+			else
+			{
+				v128::storeu(gv_addfs(v128::loadu(out), front), out);
+
+				if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
+				{
+					const v128 sides = gv_addfs(back, gv_shuffle_right<8>(back));
+
+					// When using 7.1 ouput, out_buffer[out + 4] and out_buffer[out + 5] are the rear channels, so the side channels need to be mixed into [out + 6] and [out + 7]
+					out[out_channels - 2] += sides._f[0];
+					out[out_channels - 1] += sides._f[1];
+				}
+				else if constexpr (out_channels == 6)
+				{
+					out[4] += back._f[0];
+					out[5] += back._f[1];
+				}
+				else
+				{
+					// rear_left, rear_right, side_left, side_right
+					const v128 swapped = gv_orfs(gv_shuffle_right<8>(back), gv_shuffle_left<8>(back));
+					v128::storeu(gv_addfs(v128::loadu(out + 4), swapped), out + 4);
+				}
+			}
+		}
+	}
+}
+
 template <AudioChannelCnt channels, AudioChannelCnt downmix>
 void cell_audio_thread::mix(float* out_buffer, s32 offset)
 {
@@ -1055,7 +1165,6 @@ void cell_audio_thread::mix(float* out_buffer, s32 offset)
 
 		auto buf = port.get_vm_ptr(offset);
 
-		static constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
 		float m = master_volume;
 
 		// part of cellAudioSetPortLevel functionality
@@ -1079,88 +1188,36 @@ void cell_audio_thread::mix(float* out_buffer, s32 offset)
 			m = port.level * master_volume;
 		};
 
-		if (port.num_channels == 2)
+		// Per-frame volume is only needed while the level is changing
+		float volumes[AUDIO_BUFFER_SAMPLES];
+		const bool ramp = port.level_set.load().inc != 0.0f;
+
+		if (ramp)
 		{
-			for (u32 out = 0, in = 0; out < out_buffer_sz; out += out_channels, in += 2)
+			for (float& v : volumes)
 			{
 				step_volume(port);
-
-				const float left  = buf[in + 0] * m;
-				const float right = buf[in + 1] * m;
-
-				out_buffer[out + 0] += left;
-				out_buffer[out + 1] += right;
+				v = m;
 			}
 		}
-		else if (port.num_channels == 8)
+		else
 		{
-			for (u32 out = 0, in = 0; out < out_buffer_sz; out += out_channels, in += 8)
-			{
-				step_volume(port);
-
-				const float left       = buf[in + 0] * m;
-				const float right      = buf[in + 1] * m;
-				const float center     = buf[in + 2] * m;
-				const float low_freq   = buf[in + 3] * m;
-				const float side_left  = buf[in + 4] * m;
-				const float side_right = buf[in + 5] * m;
-				const float rear_left  = buf[in + 6] * m;
-				const float rear_right = buf[in + 7] * m;
-
-				if constexpr (downmix == AudioChannelCnt::STEREO)
-				{
-					// Don't mix in the lfe as per dolby specification and based on documentation
-					const float mid = center * 0.5f;
-					out_buffer[out + 0] += left * minus_3db + mid + side_left * 0.5f + rear_left * 0.5f;
-					out_buffer[out + 1] += right * minus_3db + mid + side_right * 0.5f + rear_right * 0.5f;
-				}
-				else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
-				{
-					out_buffer[out + 0] += left;
-					out_buffer[out + 1] += right;
-
-					if constexpr (out_channels >= 6) // Only mix the surround channels into the output if surround output is configured
-					{
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-
-						if constexpr (out_channels == 6)
-						{
-							out_buffer[out + 4] += side_left + rear_left;
-							out_buffer[out + 5] += side_right + rear_right;
-						}
-						else // When using 7.1 ouput, out_buffer[out + 4] and out_buffer[out + 5] are the rear channels, so the side channels need to be mixed into [out + 6] and [out + 7]
-						{
-							out_buffer[out + 6] += side_left + rear_left;
-							out_buffer[out + 7] += side_right + rear_right;
-						}
-					}
-				}
-				else
-				{
-					out_buffer[out + 0] += left;
-					out_buffer[out + 1] += right;
+			step_volume(port);
+		}
 
-					if constexpr (out_channels >= 6) // Only mix the surround channels into the output if surround output is configured
-					{
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-
-						if constexpr (out_channels == 6)
-						{
-							out_buffer[out + 4] += side_left;
-							out_buffer[out + 5] += side_right;
-						}
-						else
-						{
-							out_buffer[out + 4] += rear_left;
-							out_buffer[out + 5] += rear_right;
-							out_buffer[out + 6] += side_left;
-							out_buffer[out + 7] += side_right;
-						}
-					}
-				}
-			}
+		if (port.num_channels == 2)
+		{
+			if (ramp)
+				mix_port<out_channels, 2, downmix, true>(out_buffer, buf, m, volumes);
+			else
+				mix_port<out_channels, 2, downmix, false>(out_buffer, buf, m, volumes);
+		}
+		else if (port.num_channels == 8)
+		{
+			if (ramp)
+				mix_port<out_channels, 8, downmix, true>(out_buffer, buf, m, volumes);
+			else
+				mix_port<out_channels, 8, downmix, false>(out_buffer, buf, m, volumes);
 		}
 		else
 		{
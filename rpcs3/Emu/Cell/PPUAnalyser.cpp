@@ -4,8 +4,11 @@
 #include "PPUOpcodes.h"
 #include "PPUModule.h"
 #include "Emu/system_config.h"
+#include "Emu/system_utils.hpp"
+#include "Utilities/Thread.h"
 
 #include <unordered_set>
+#include <chrono>
 #include "util/yaml.hpp"
 #include "util/asm.hpp"
 
@@ -530,8 +533,79 @@ namespace ppu_patterns
 	};
 }
 
+// Scan words of a memory range in parallel, op(ptr, out) may append results to out
+// Results of each chunk are concatenated in address order, so the output is the same as of a sequential scan
+template <typename F>
+static std::vector<u32> ppu_scan_range(u32 addr, u32 size, F op)
+{
+	// 1 MiB chunks
+	constexpr u32 chunk_size = 1 << 20;
+
+	const u32 chunk_count = utils::aligned_div(size, chunk_size);
+
+	std::vector<std::vector<u32>> results(chunk_count);
+
+	const auto scan_chunk = [&](u32 index)
+	{
+		const u32 chunk_end = addr + std::min<u32>(size, (index + 1) * chunk_size);
+
+		for (vm::cptr<u32> ptr = vm::cast(addr + index * chunk_size); ptr.addr() < chunk_end; ptr++)
+		{
+			op(ptr, results[index]);
+		}
+	};
+
+	const u32 thread_count = std::min<u32>(rpcs3::utils::get_max_threads(), chunk_count);
+
+	if (thread_count <= 1)
+	{
+		for (u32 i = 0; i < chunk_count; i++)
+		{
+			scan_chunk(i);
+		}
+	}
+	else
+	{
+		atomic_t<u32> next_chunk = 0;
+
+		named_thread_group workers("PPU Analyser ", thread_count, [&]()
+		{
+			for (u32 index; (index = next_chunk++) < chunk_count;)
+			{
+				scan_chunk(index);
+			}
+		});
+
+		workers.join();
+	}
+
+	if (chunk_count == 1)
+	{
+		return std::move(results[0]);
+	}
+
+	usz total = 0;
+
+	for (const auto& result : results)
+	{
+		total += result.size();
+	}
+
+	std::vector<u32> out;
+	out.reserve(total);
+
+	for (const auto& result : results)
+	{
+		out.insert(out.end(), result.begin(), result.end());
+	}
+
+	return out;
+}
+
 void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::basic_string<u32>& applied)
 {
+	const auto time0 = std::chrono::steady_clock::now();
+
 	// Assume first segment is executable
 	const u32 start = segs[0].addr;
 
@@ -548,8 +622,13 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	// Function analysis workload
 	std::vector<std::reference_wrapper<ppu_function>> func_queue;
 
-	// Known references (within segs, addr and value alignment = 4)
-	std::set<u32> addr_heap{entry};
+	// Known references (within segs, addr and value alignment = 4), sorted
+	std::vector<u32> addr_heap{entry};
+
+	auto is_heap_addr = [&](u32 addr)
+	{
+		return std::binary_search(addr_heap.begin(), addr_heap.end(), addr);
+	};
 
 	// Register new function
 	auto add_func = [&](u32 addr, u32 toc, u32 caller) -> ppu_function&
@@ -598,15 +677,29 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		{
 			if (!seg.addr) continue;
 
-			for (vm::cptr<u32> ptr = vm::cast(seg.addr); ptr.addr() < seg.addr + seg.size; ptr++)
+			const auto found = ppu_scan_range(seg.addr, seg.size, [&](vm::cptr<u32> ptr, std::vector<u32>& out)
 			{
 				if (ptr[0] >= start && ptr[0] < end && ptr[0] % 4 == 0 && ptr[1] == toc)
 				{
-					// New function
-					ppu_log.trace("OPD*: [0x%x] 0x%x (TOC=0x%x)", ptr, ptr[0], ptr[1]);
-					add_func(*ptr, addr_heap.count(ptr.addr()) ? toc : 0, 0);
-					ptr++;
+					out.push_back(ptr.addr());
+				}
+			});
+
+			// Entries are 8 bytes: the word following a matched entry is not an entry itself
+			u32 skip = 0;
+
+			for (u32 addr : found)
+			{
+				if (skip && addr == skip)
+				{
+					continue;
 				}
+
+				// New function
+				const vm::cptr<u32> ptr = vm::cast(addr);
+				ppu_log.trace("OPD*: [0x%x] 0x%x (TOC=0x%x)", ptr, ptr[0], ptr[1]);
+				add_func(*ptr, is_heap_addr(ptr.addr()) ? toc : 0, 0);
+				skip = addr + 4;
 			}
 		}
 	};
@@ -623,28 +716,24 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	{
 		if (!seg.addr) continue;
 
-		for (vm::cptr<u32> ptr = vm::cast(seg.addr); ptr.addr() < seg.addr + seg.size; ptr++)
+		const auto found = ppu_scan_range(seg.addr, seg.size, [&](vm::cptr<u32> ptr, std::vector<u32>& out)
 		{
 			const u32 value = *ptr;
 
-			if (value % 4)
+			if (value % 4 == 0 && value >= start && value < end)
 			{
-				continue;
+				out.push_back(value);
 			}
+		});
 
-			for (const auto& _seg : segs)
-			{
-				if (!_seg.addr) continue;
-
-				if (value >= start && value < end)
-				{
-					addr_heap.emplace(value);
-					break;
-				}
-			}
-		}
+		addr_heap.insert(addr_heap.end(), found.begin(), found.end());
 	}
 
+	std::sort(addr_heap.begin(), addr_heap.end());
+	addr_heap.erase(std::unique(addr_heap.begin(), addr_heap.end()), addr_heap.end());
+
+	const auto time1 = std::chrono::steady_clock::now();
+
 	// Find OPD section
 	for (const auto& sec : secs)
 	{
@@ -700,7 +789,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 			ppu_log.trace("OPD: [0x%x] 0x%x (TOC=0x%x)", ptr, addr, toc);
 
 			TOCs.emplace(toc);
-			auto& func = add_func(addr, addr_heap.count(ptr.addr()) ? toc : 0, 0);
+			auto& func = add_func(addr, is_heap_addr(ptr.addr()) ? toc : 0, 0);
 			func.attr += ppu_attr::known_addr;
 			known_functions.emplace(addr);
 		}
@@ -1184,7 +1273,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 			const u32 func_end2 = _next == fmap.end() ? func_end : std::min<u32>(_next->first, func_end);
 
 			// Set more block entries
-			std::for_each(addr_heap.lower_bound(func.addr), addr_heap.lower_bound(func_end2), add_block);
+			std::for_each(std::lower_bound(addr_heap.begin(), addr_heap.end(), func.addr), std::lower_bound(addr_heap.begin(), addr_heap.end(), func_end2), add_block);
 		}
 
 		const bool was_empty = block_queue.empty();
@@ -1525,6 +1614,8 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		}
 	}
 
+	const auto time2 = std::chrono::steady_clock::now();
+
 	ppu_log.notice("Function analysis: %zu functions (%zu enqueued)", fmap.size(), func_queue.size());
 
 	// Decompose functions to basic blocks
@@ -1617,7 +1708,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		case 109:
 		case 110:
 		{
-			ppu_log.trace("Added block from reloc: 0x%x (0x%x, %u) (heap=%d)", target, rel.addr, rel.type, addr_heap.count(target));
+			ppu_log.trace("Added block from reloc: 0x%x (0x%x, %u) (heap=%d)", target, rel.addr, rel.type, is_heap_addr(target));
 			block_queue.emplace_back(target, 0);
 			block_set.emplace(target);
 			continue;
@@ -1843,6 +1934,16 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	}
 
 	ppu_log.notice("Block analysis: %zu blocks (%zu enqueued)", funcs.size(), block_queue.size());
+
+	const auto to_ms = [](auto duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	};
+
+	const auto time3 = std::chrono::steady_clock::now();
+
+	ppu_log.notice("PPU analysis took %.2fms (references: %.2fms, functions: %.2fms, blocks: %.2fms, %zu references)",
+		to_ms(time3 - time0), to_ms(time1 - time0), to_ms(time2 - time1), to_ms(time3 - time2), addr_heap.size());
 }
 
 // Temporarily
@@ -2,11 +2,16 @@
 
 #include "PPUThread.h"
 #include "PPUInterpreter.h"
+#include "Emu/trace_events.hpp"
 
 #include "util/v128.hpp"
 
 // BIND_FUNC macro "converts" any appropriate HLE function to ppu_intrp_func_t, binding it to PPU thread context.
-#define BIND_FUNC(func, ...) (static_cast<ppu_intrp_func_t>([](ppu_thread& ppu, ppu_opcode_t, be_t<u32>* this_op, ppu_intrp_func*) {\
+#define BIND_FUNC(func, ...) BIND_FUNC_TRACE(trace_category::hle, func, __VA_ARGS__)
+
+// Same as BIND_FUNC, with explicit category for trace events
+#define BIND_FUNC_TRACE(trace_cat, func, ...) (static_cast<ppu_intrp_func_t>([](ppu_thread& ppu, ppu_opcode_t, be_t<u32>* this_op, ppu_intrp_func*) {\
+	trace_scope trace(trace_cat, #func);\
 	const auto old_f = ppu.current_function;\
 	if (!old_f) ppu.last_function = #func;\
 	ppu.current_function = #func;\
@@ -1349,6 +1349,25 @@ void ppu_thread::dump_all(std::string& ret) const
 
 extern thread_local std::string(*g_tls_log_prefix)();
 
+// Get PPU thread name for log prefix (cached in thread-local storage)
+static const std::string& ppu_get_name_cached(ppu_thread* _this)
+{
+	static thread_local shared_ptr<std::string> name_cache;
+
+	if (!_this->ppu_tname.is_equal(name_cache)) [[unlikely]]
+	{
+		_this->ppu_tname.peek_op([&](const shared_ptr<std::string>& ptr)
+		{
+			if (ptr != name_cache)
+			{
+				name_cache = ptr;
+			}
+		});
+	}
+
+	return *name_cache.get();
+}
+
 void ppu_thread::cpu_task()
 {
 	std::fesetround(FE_TONEAREST);
@@ -1917,6 +1936,7 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc)
 	const auto old_lr = lr;
 	const auto old_func = current_function;
 	const auto old_fmt = g_tls_log_prefix;
+	const auto old_raw_fmt = logs::get_tls_raw_prefix();
 
 	interrupt_thread_executing = true;
 	cia = addr;
@@ -1932,36 +1952,44 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc)
 	g_tls_log_prefix = []
 	{
 		const auto _this = static_cast<ppu_thread*>(get_current_cpu_thread());
+		const auto cia = _this->cia;
+
+		if (_this->current_function && vm::read32(cia) != ppu_instructions::SC(0))
+		{
+			return fmt::format("PPU[0x%x] Thread (%s) [HLE:0x%08x, LR:0x%08x]", _this->id, ppu_get_name_cached(_this), cia, _this->lr);
+		}
 
-		static thread_local shared_ptr<std::string> name_cache;
+		extern const char* get_prx_name_by_cia(u32 addr);
 
-		if (!_this->ppu_tname.is_equal(name_cache)) [[unlikely]]
+		if (auto name = get_prx_name_by_cia(cia))
 		{
-			_this->ppu_tname.peek_op([&](const shared_ptr<std::string>& ptr)
-			{
-				if (ptr != name_cache)
-				{
-					name_cache = ptr;
-				}
-			});
+			return fmt::format("PPU[0x%x] Thread (%s) [%s: 0x%08x]", _this->id, ppu_get_name_cached(_this), name, cia);	
 		}
 
+		return fmt::format("PPU[0x%x] Thread (%s) [0x%08x]", _this->id, ppu_get_name_cached(_this), cia);
+	};
+
+	logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+	{
+		const auto _this = static_cast<ppu_thread*>(get_current_cpu_thread());
 		const auto cia = _this->cia;
 
 		if (_this->current_function && vm::read32(cia) != ppu_instructions::SC(0))
 		{
-			return fmt::format("PPU[0x%x] Thread (%s) [HLE:0x%08x, LR:0x%08x]", _this->id, *name_cache.get(), cia, _this->lr);
+			prefix.set("PPU[0x%x] Thread (%s) [HLE:0x%08x, LR:0x%08x]", _this->id, ppu_get_name_cached(_this), cia, _this->lr);
+			return;
 		}
 
 		extern const char* get_prx_name_by_cia(u32 addr);
 
 		if (auto name = get_prx_name_by_cia(cia))
 		{
-			return fmt::format("PPU[0x%x] Thread (%s) [%s: 0x%08x]", _this->id, *name_cache.get(), name, cia);	
+			prefix.set("PPU[0x%x] Thread (%s) [%s: 0x%08x]", _this->id, ppu_get_name_cached(_this), name, cia);
+			return;
 		}
 
-		return fmt::format("PPU[0x%x] Thread (%s) [0x%08x]", _this->id, *name_cache.get(), cia);
-	};
+		prefix.set("PPU[0x%x] Thread (%s) [0x%08x]", _this->id, ppu_get_name_cached(_this), cia);
+	});
 
 	auto at_ret = [&]()
 	{
@@ -1984,6 +2012,7 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc)
 
 		current_function = old_func;
 		g_tls_log_prefix = old_fmt;
+		logs::set_tls_raw_prefix(old_raw_fmt);
 		state -= cpu_flag::ret;
 	};
 
@@ -2691,12 +2720,51 @@ extern bool ppu_stdcx(ppu_thread& ppu, u32 addr, u64 reg_value)
 #ifdef LLVM_AVAILABLE
 namespace
 {
+	// Object file part which is linked on first use (lazy linking mode)
+	struct jit_module_part
+	{
+		std::string obj_name;
+
+		// Symbol offsets and indices in jit_module::funcs
+		std::vector<std::pair<u32, usz>> funcs;
+
+		// Installed function addresses and indices in funcs (one entry per load of the module)
+		std::vector<std::pair<u32, usz>> installs;
+
+		// Protected by jit_module_manager::mutex
+		enum class link_state : u8
+		{
+			unlinked,
+			linking,
+			linked,
+		} state = link_state::unlinked;
+	};
+
+	// Lazy linking info, outlives the module while one of its parts is being linked
+	struct jit_lazy_module
+	{
+		// Serializes linking (single MCJIT instance per module)
+		shared_mutex mutex;
+
+		std::shared_ptr<jit_compiler> pjit;
+		std::string cache_path;
+		jit_object_pack obj_pack;
+		std::vector<jit_module_part> parts;
+
+		// Part and index in jit_module_part::funcs for each entry in jit_module::funcs
+		std::vector<std::pair<usz, usz>> func_parts;
+
+		usz parts_linked = 0;
+	};
+
 	// Compiled PPU module info
 	struct jit_module
 	{
 		std::vector<ppu_intrp_func_t> funcs;
 		std::shared_ptr<jit_compiler> pjit;
 		bool init = false;
+
+		std::shared_ptr<jit_lazy_module> lazy;
 	};
 
 	struct jit_module_manager
@@ -2704,6 +2772,12 @@ namespace
 		shared_mutex mutex;
 		std::unordered_map<std::string, jit_module> map;
 
+		// Function address -> lazily linked module part
+		std::unordered_map<u32, std::pair<std::shared_ptr<jit_lazy_module>, usz>> lazy_funcs;
+
+		// Stubs for calls into lazily linked parts
+		::jit_runtime rt;
+
 		jit_module& get(const std::string& name)
 		{
 			std::lock_guard lock(mutex);
@@ -2722,10 +2796,224 @@ namespace
 				return;
 			}
 
+			if (const auto& lazy = found->second.lazy)
+			{
+				std::erase_if(lazy_funcs, [&](const auto& pair) { return pair.second.first == lazy; });
+			}
+
+			report(found->first, found->second);
+
 			map.erase(found);
 		}
+
+		static void report(const std::string& name, const jit_module& mod)
+		{
+			if (mod.lazy)
+			{
+				ppu_log.notice("LLVM: Lazy linking stats for %s: %u/%u parts linked", name, mod.lazy->parts_linked, mod.lazy->parts.size());
+			}
+		}
+
+		jit_module_manager() noexcept = default;
+
+		jit_module_manager(const jit_module_manager&) = delete;
+
+		jit_module_manager& operator=(const jit_module_manager&) = delete;
+
+		~jit_module_manager()
+		{
+			for (const auto& [name, mod] : map)
+			{
+				report(name, mod);
+			}
+		}
 	};
+
+	// Generate a stub which sets CIA and jumps through the executable cache (used for calls into lazily linked parts)
+	// For relocatable modules CIA is computed from the segment base passed along, so the stub is valid for every load
+	ppu_intrp_func_t ppu_gen_lazy_stub(::jit_runtime& rt, u32 offset, bool is_reloc)
+	{
+		return build_function_asm<ppu_intrp_func_t>("", [&](native_asm& c, auto&)
+		{
+			using namespace asmjit;
+
+#ifdef ARCH_X64
+			// rbp = ppu_thread, r13 = executable cache base, r12 = segment base
+			if (is_reloc)
+				c.lea(x86::eax, x86::dword_ptr(x86::r12, static_cast<s32>(offset)));
+			else
+				c.mov(x86::eax, offset);
+
+			c.mov(x86::dword_ptr(x86::rbp, ::offset32(&ppu_thread::cia)), x86::eax);
+			c.mov(x86::rax, x86::qword_ptr(x86::r13, x86::rax, 1));
+			c.shl(x86::rax, 16);
+			c.shr(x86::rax, 16);
+			c.jmp(x86::rax);
+#else
+			// x20 = ppu_thread, x19 = executable cache base, x21 = segment base
+			Label imm_address = c.newLabel();
+
+			c.ldr(a64::w9, arm::ptr(imm_address));
+
+			if (is_reloc)
+				c.add(a64::w9, a64::w9, a64::w21);
+
+			c.str(a64::w9, arm::Mem(a64::x20, ::offset32(&ppu_thread::cia)));
+			c.add(a64::x10, a64::x9, a64::x9);
+			c.ldr(a64::x11, arm::Mem(a64::x19, a64::x10));
+			c.and_(a64::x11, a64::x11, Imm(0xffff'ffff'ffff));
+			c.br(a64::x11);
+
+			c.align(AlignMode::kCode, 16);
+			c.bind(imm_address);
+			c.embedUInt32(offset);
+#endif
+		}, &rt);
+	}
+}
+
+enum class ppu_lazy_link_result
+{
+	not_found,
+	busy,
+	linked,
+};
+
+// Link module part containing the function at specified address
+static ppu_lazy_link_result ppu_link_lazy_part(u32 addr)
+{
+	auto& manager = g_fxo->get<jit_module_manager>();
+
+	std::unique_lock lock(manager.mutex);
+
+	const auto found = manager.lazy_funcs.find(addr);
+
+	if (found == manager.lazy_funcs.end())
+	{
+		return ppu_lazy_link_result::not_found;
+	}
+
+	const std::shared_ptr<jit_lazy_module> mod = found->second.first;
+	auto& part = mod->parts[found->second.second];
+
+	if (part.state == jit_module_part::link_state::linked)
+	{
+		return ppu_lazy_link_result::linked;
+	}
+
+	if (part.state == jit_module_part::link_state::linking)
+	{
+		return ppu_lazy_link_result::busy;
+	}
+
+	part.state = jit_module_part::link_state::linking;
+
+	// Link without holding the global lock, other threads interpret this part meanwhile
+	lock.unlock();
+
+	std::vector<ppu_intrp_func_t> ptrs;
+	ptrs.reserve(part.funcs.size());
+
+	{
+		std::lock_guard link_lock(mod->mutex);
+
+#ifdef __APPLE__
+		pthread_jit_write_protect_np(false);
+#endif
+		jit_compiler& jit = *mod->pjit;
+
+		for (const auto& [offset, func_index] : part.funcs)
+		{
+			// Remove stub mapping so that the function is resolved to its own definition
+			jit.update_global_mapping(fmt::format("__0x%x", offset), 0);
+		}
+
+		if (!jit.add(mod->obj_pack, part.obj_name))
+		{
+			jit.add(mod->cache_path + part.obj_name);
+		}
+
+		jit.fin();
+
+		for (const auto& [offset, func_index] : part.funcs)
+		{
+			ptrs.emplace_back(ensure(reinterpret_cast<ppu_intrp_func_t>(jit.get(fmt::format("__0x%x", offset)))));
+		}
+
+#ifdef __APPLE__
+		pthread_jit_write_protect_np(true);
+#endif
+#if defined(ARCH_ARM64)
+		// Flush all cache lines after potentially writing executable code
+		asm("ISB");
+		asm("DSB ISH");
+#endif
+	}
+
+	lock.lock();
+
+	// Install the part at every address it has been loaded at, unless the module was released meanwhile
+	const auto jit_mod = std::find_if(manager.map.begin(), manager.map.end(), [&](const auto& pair) { return pair.second.lazy == mod; });
+
+	if (jit_mod != manager.map.end())
+	{
+		for (usz i = 0; i < part.funcs.size(); i++)
+		{
+			jit_mod->second.funcs[part.funcs[i].second] = ptrs[i];
+		}
+
+		for (const auto& [func_addr, i] : part.installs)
+		{
+			ppu_register_function_at(func_addr, 4, ptrs[i]);
+		}
+	}
+
+	part.state = jit_module_part::link_state::linked;
+	mod->parts_linked++;
+
+	ppu_log.notice("LLVM: Linked module %s on first call to 0x%x (%u/%u)", part.obj_name, addr, mod->parts_linked, mod->parts.size());
+	return ppu_lazy_link_result::linked;
 }
+
+static void ppu_lazy_link(ppu_thread& ppu)
+{
+	perf_meter<"PPULINK"_u64> perf0;
+
+	switch (ppu_link_lazy_part(ppu.cia))
+	{
+	case ppu_lazy_link_result::linked:
+	{
+		// Return to the gateway which calls the linked function
+		return;
+	}
+	case ppu_lazy_link_result::busy:
+	{
+		// Another thread is linking this part: run one instruction in the interpreter,
+		// the gateway then continues with ppu_recompiler_fallback until the next registered function
+		const u32 op = vm::read32(ppu.cia);
+		g_fxo->get<ppu_interpreter_rt>().decode(op)(ppu, {op}, vm::_ptr<u32>(ppu.cia), &ppu_ret);
+		return;
+	}
+	case ppu_lazy_link_result::not_found:
+	{
+		// Nothing left to link at this address, install the interpreter fallback
+		ppu_register_function_at(ppu.cia, 4, reinterpret_cast<ppu_intrp_func_t>(ppu_recompiler_fallback_ghc));
+		return ppu_recompiler_fallback(ppu);
+	}
+	}
+}
+
+#if defined(ARCH_X64)
+static const auto ppu_lazy_link_ghc = build_function_asm<void(*)(ppu_thread& ppu)>("", [](native_asm& c, auto& args)
+{
+	using namespace asmjit;
+
+	c.mov(args[0], x86::rbp);
+	c.jmp(ppu_lazy_link);
+});
+#elif defined(ARCH_ARM64)
+static const auto ppu_lazy_link_ghc = &ppu_lazy_link;
+#endif
 #endif
 
 namespace
@@ -3382,6 +3670,26 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 	// Compiler instance (deferred initialization)
 	std::shared_ptr<jit_compiler>& jit = jit_mod.pjit;
 
+	// Config options that feed into the object settings below, so that each configuration keeps its own pack
+	const be_t<u32> pack_config =
+		u32{!!g_cfg.core.use_accurate_dfma} << 0 |
+		u32{!!g_cfg.core.ppu_fix_vnan} << 1 |
+		u32{!!g_cfg.core.ppu_llvm_nj_fixup} << 2 |
+		u32{!!g_cfg.core.accurate_cache_line_stores} << 3 |
+		u32{g_cfg.core.ppu_128_reservations_loop_max_length != 0} << 4 |
+		u32{!!g_cfg.core.ppu_llvm_greedy_mode} << 5 |
+		u32{!!g_cfg.core.ppu_set_sat_bit} << 6;
+
+	// Packed object cache for this module (single file, memory-mapped)
+	const std::string pack_path = fmt::format("%sv5-kusa-%s-%s-%s.objpack", cache_path, fmt::base57(info.sha1), fmt::base57(pack_config), jit_compiler::cpu(g_cfg.core.llvm_cpu));
+
+	jit_object_pack obj_pack;
+
+	if (!jit_mod.init)
+	{
+		obj_pack = jit_object_pack(pack_path);
+	}
+
 	// Split module into fragments <= 1 MiB
 	usz fpos = 0;
 
@@ -3394,6 +3702,12 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 	// Info to load to main JIT instance (true - compiled)
 	std::vector<std::pair<std::string, bool>> link_workload;
 
+	// Function addresses of each part in link_workload
+	std::vector<std::vector<u32>> link_funcs;
+
+	// Link parts on first call
+	const bool lazy_link = g_cfg.core.ppu_llvm_lazy_linking && !check_only;
+
 	// Sync variable to acquire workloads
 	atomic_t<u32> work_cv = 0;
 
@@ -3663,10 +3977,20 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 			g_progr_ptotal++;
 
 			link_workload.emplace_back(obj_name, false);
+
+			auto& addrs = link_funcs.emplace_back();
+
+			for (const auto& func : part.funcs)
+			{
+				if (func.size)
+				{
+					addrs.emplace_back(func.addr);
+				}
+			}
 		}
 
 		// Check object file
-		if (jit_compiler::check(cache_path + obj_name))
+		if (obj_pack.contains(obj_name) || jit_compiler::check(cache_path + obj_name))
 		{
 			if (!jit && !check_only)
 			{
@@ -3721,6 +4045,8 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 		// Prevent watchdog thread from terminating
 		g_watchdog_hold_ctr++;
 
+		jit_compile_stats stats;
+
 		named_thread_group threads(fmt::format("PPUW.%u.", ++g_fxo->get<thread_index_allocator>().index), thread_count, [&]()
 		{
 			// Set low priority
@@ -3749,18 +4075,58 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 
 				ppu_log.warning("LLVM: Compiling module %s%s", cache_path, obj_name);
 
+				const auto time0 = std::chrono::steady_clock::now();
+
 				// Use another JIT instance
 				jit_compiler jit2({}, g_cfg.core.llvm_cpu, 0x1);
 				ppu_initialize2(jit2, part, cache_path, obj_name);
 
+				stats.add(std::chrono::steady_clock::now() - time0, part.funcs.size());
+
 				ppu_log.success("LLVM: Compiled module %s", obj_name);
 			}
 		});
 
 		threads.join();
 
+		if (!workload.empty() && !Emu.IsStopped())
+		{
+			ppu_log.notice("LLVM: Compilation statistics: %s", stats.summary(thread_count));
+		}
+
 		g_watchdog_hold_ctr--;
 
+		// Repack if some objects are only available as loose files or the pack contains stale objects
+		if (!Emu.IsStopped() && (obj_pack.size() != link_workload.size() || std::any_of(link_workload.begin(), link_workload.end(), [&](auto& obj) { return !obj_pack.contains(obj.first); })))
+		{
+			std::vector<std::string> names;
+			std::vector<std::string> imported;
+
+			for (const auto& [obj_name, is_compiled] : link_workload)
+			{
+				if (!obj_pack.contains(obj_name))
+				{
+					imported.emplace_back(obj_name);
+				}
+
+				names.emplace_back(obj_name);
+			}
+
+			const bool packed = jit_object_pack::write(pack_path, names, std::move(obj_pack), cache_path);
+
+			obj_pack = jit_object_pack(pack_path);
+
+			if (packed && obj_pack)
+			{
+				// Remove imported object files
+				for (const auto& obj_name : imported)
+				{
+					fs::remove_file(cache_path + obj_name + ".gz");
+					fs::remove_file(cache_path + obj_name);
+				}
+			}
+		}
+
 		if (Emu.IsStopped() || !get_current_cpu_thread())
 		{
 			return compiled_new;
@@ -3772,6 +4138,29 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 			g_progr = "Linking PPU modules...";
 		}
 
+		if (obj_pack && !lazy_link)
+		{
+			// Prefetch packed objects in parallel, relocation itself must be done by the single JIT instance
+			atomic_t<usz> prefetch_index = 0;
+
+			named_thread_group prefetch("PPU Prefetch ", std::min<u32>(rpcs3::utils::get_max_threads(), ::size32(link_workload)), [&]()
+			{
+				u8 sum = 0;
+
+				for (usz i = prefetch_index++; i < link_workload.size(); i = prefetch_index++)
+				{
+					const auto [ptr, size] = obj_pack.get(link_workload[i].first);
+
+					for (u64 off = 0; off < size; off += 4096)
+					{
+						sum += ptr[off];
+					}
+				}
+
+				return sum;
+			});
+		}
+
 		for (auto [obj_name, is_compiled] : link_workload)
 		{
 			if (Emu.IsStopped())
@@ -3779,12 +4168,24 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 				break;
 			}
 
-			jit->add(cache_path + obj_name);
+			if (!is_compiled)
+			{
+				g_progr_pdone++;
+			}
+
+			if (lazy_link)
+			{
+				continue;
+			}
+
+			if (!jit->add(obj_pack, obj_name))
+			{
+				jit->add(cache_path + obj_name);
+			}
 
 			if (!is_compiled)
 			{
 				ppu_log.success("LLVM: Loaded module %s", obj_name);
-				g_progr_pdone++;
 			}
 		}
 	}
@@ -3798,7 +4199,66 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 #ifdef __APPLE__
 	pthread_jit_write_protect_np(false);
 #endif
-	if (jit && !jit_mod.init)
+	if (jit && !jit_mod.init && lazy_link)
+	{
+		auto& manager = g_fxo->get<jit_module_manager>();
+
+		std::lock_guard lock(manager.mutex);
+
+		const auto lazy = std::make_shared<jit_lazy_module>();
+		lazy->pjit = jit;
+		lazy->cache_path = cache_path;
+		lazy->obj_pack = std::move(obj_pack);
+
+		std::unordered_map<u32, usz> part_index;
+
+		for (usz i = 0; i < link_workload.size(); i++)
+		{
+			lazy->parts.emplace_back().obj_name = link_workload[i].first;
+
+			for (u32 addr : link_funcs[i])
+			{
+				part_index.emplace(addr, i);
+
+				// Calls from other parts go through the executable cache until this part is linked
+				jit->update_global_mapping(fmt::format("__0x%x", addr - reloc), reinterpret_cast<u64>(ppu_gen_lazy_stub(manager.rt, addr - reloc, !info.relocs.empty())));
+			}
+		}
+
+		// Install link stubs
+		for (const auto& func : info.funcs)
+		{
+			if (!func.size) continue;
+
+			ppu_intrp_func_t addr = nullptr;
+
+			if (const auto found = part_index.find(func.addr); found != part_index.end())
+			{
+				auto& part = lazy->parts[found->second];
+
+				addr = reinterpret_cast<ppu_intrp_func_t>(ppu_lazy_link_ghc);
+				lazy->func_parts.emplace_back(found->second, part.funcs.size());
+				part.installs.emplace_back(func.addr, part.funcs.size());
+				part.funcs.emplace_back(func.addr - reloc, jit_mod.funcs.size());
+				manager.lazy_funcs.insert_or_assign(func.addr, std::make_pair(lazy, found->second));
+			}
+			else
+			{
+				addr = ensure(reinterpret_cast<ppu_intrp_func_t>(jit->get(fmt::format("__0x%x", func.addr - reloc))));
+				lazy->func_parts.emplace_back(umax, umax);
+			}
+
+			jit_mod.funcs.emplace_back(addr);
+
+			ppu_register_function_at(func.addr, 4, addr);
+		}
+
+		ppu_log.notice("LLVM: %u parts will be linked on first call", lazy->parts.size());
+
+		jit_mod.lazy = lazy;
+		jit_mod.init = true;
+	}
+	else if (jit && !jit_mod.init)
 	{
 		jit->fin();
 
@@ -3823,12 +4283,31 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 	{
 		usz index = 0;
 
+		auto& manager = g_fxo->get<jit_module_manager>();
+
+		// Lazily linked parts may still be linked from another thread
+		std::unique_lock lock(manager.mutex, std::defer_lock);
+
+		if (jit_mod.lazy)
+		{
+			lock.lock();
+		}
+
 		// Locate existing functions
 		for (const auto& func : info.funcs)
 		{
 			if (!func.size) continue;
 
-			const u64 addr = reinterpret_cast<uptr>(ensure(jit_mod.funcs[index++]));
+			const usz func_index = index++;
+			const u64 addr = reinterpret_cast<uptr>(ensure(jit_mod.funcs[func_index]));
+
+			if (jit_mod.lazy && addr == reinterpret_cast<uptr>(ppu_lazy_link_ghc))
+			{
+				// Not linked yet: register the new address with its part so that it is installed when the part is linked
+				const auto [part_index, index_in_part] = jit_mod.lazy->func_parts[func_index];
+				jit_mod.lazy->parts[part_index].installs.emplace_back(func.addr, index_in_part);
+				manager.lazy_funcs.insert_or_assign(func.addr, std::make_pair(jit_mod.lazy, part_index));
+			}
 
 			ppu_register_function_at(func.addr, 4, addr);
 
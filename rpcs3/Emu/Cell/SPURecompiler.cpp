@@ -516,52 +516,129 @@ spu_cache::~spu_cache()
 {
 }
 
-std::deque<spu_program> spu_cache::get()
+std::vector<spu_cache_entry> spu_cache::get()
 {
-	std::deque<spu_program> result;
+	std::vector<spu_cache_entry> result;
 
 	if (!m_file)
 	{
 		return result;
 	}
 
-	m_file.seek(0);
+	m_map = fs::file_map(m_file);
 
-	// TODO: signal truncated or otherwise broken file
-	while (true)
+	if (!m_map)
+	{
+		return result;
+	}
+
+	const u8* const data = m_map.data();
+	const u64 size = m_map.size();
+
+	// Record: size (in words), LS address, program data
+	struct header_t
 	{
 		be_t<u32> size;
 		be_t<u32> addr;
-		std::vector<u32> func;
+	};
+
+	// Identical programs may be recorded multiple times (e.g. by concurrent SPU threads)
+	struct entry_hash
+	{
+		usz operator()(const spu_cache_entry& e) const noexcept
+		{
+			return std::hash<std::string_view>()({reinterpret_cast<const char*>(e.data.data()), e.data.size_bytes()}) ^ e.entry_point;
+		}
+	};
+
+	struct entry_eq
+	{
+		bool operator()(const spu_cache_entry& a, const spu_cache_entry& b) const noexcept
+		{
+			return a.entry_point == b.entry_point && std::equal(a.data.begin(), a.data.end(), b.data.begin(), b.data.end());
+		}
+	};
+
+	std::unordered_set<spu_cache_entry, entry_hash, entry_eq> unique;
+
+	u64 pos = 0;
+	u32 skipped = 0;
+	u32 duplicates = 0;
 
-		if (!m_file.read(size) || !m_file.read(addr))
+	while (pos < size)
+	{
+		if (size - pos < sizeof(header_t))
 		{
 			break;
 		}
 
-		func.resize(size);
+		header_t header;
+		std::memcpy(&header, data + pos, sizeof(header));
+
+		const u32 words = header.size;
+		const u32 addr = header.addr;
 
-		if (m_file.read(func.data(), func.size() * 4) != func.size() * 4)
+		if (words > SPU_LS_SIZE / 4 || size - pos - sizeof(header_t) < words * u64{4})
 		{
+			// Corrupted size or truncated record
 			break;
 		}
 
-		if (!size || !func[0])
+		const spu_cache_entry entry{addr, {reinterpret_cast<const u32*>(data + pos + sizeof(header_t)), words}};
+
+		pos += sizeof(header_t) + words * u64{4};
+
+		if (!words || !entry.data[0])
 		{
 			// Skip old format Giga entries
 			continue;
 		}
 
-		spu_program res;
-		res.entry_point = addr;
-		res.lower_bound = addr;
-		res.data = std::move(func);
-		result.emplace_front(std::move(res));
+		if (addr % 4 || addr >= SPU_LS_SIZE || words > (SPU_LS_SIZE - addr) / 4)
+		{
+			// Doesn't fit in LS
+			skipped++;
+			continue;
+		}
+
+		if (!unique.emplace(entry).second)
+		{
+			duplicates++;
+			continue;
+		}
+
+		result.emplace_back(entry);
+	}
+
+	if (pos < size)
+	{
+		spu_log.error("SPU Cache: invalid data at offset 0x%x (file size 0x%x), the rest of the file will be discarded.", pos, size);
+		m_valid_size = pos;
 	}
 
+	if (skipped)
+	{
+		spu_log.error("SPU Cache: skipped %u invalid programs.", skipped);
+	}
+
+	spu_log.notice("SPU Cache: read %u programs (%u duplicates).", result.size(), duplicates);
+
+	// Most recently added programs first
+	std::reverse(result.begin(), result.end());
 	return result;
 }
 
+void spu_cache::release_map()
+{
+	m_map = {};
+
+	if (m_valid_size != umax)
+	{
+		// Remove damaged tail so new records can be appended
+		m_file.trunc(std::exchange(m_valid_size, umax));
+	}
+}
+
 void spu_cache::add(const spu_program& func)
 {
 	if (!m_file)
@@ -655,6 +732,8 @@ void spu_cache::initialize()
 		worker_count = rpcs3::utils::get_max_threads();
 	}
 
+	jit_compile_stats stats;
+
 	named_thread_group workers("SPU Worker ", worker_count, [&]() -> uint
 	{
 #ifdef __APPLE__
@@ -686,7 +765,7 @@ void spu_cache::initialize()
 		// Build functions
 		for (usz func_i = fnext++; func_i < func_list.size(); func_i = fnext++, g_progr_pdone++)
 		{
-			const spu_program& func = std::as_const(func_list)[func_i];
+			const spu_cache_entry& func = std::as_const(func_list)[func_i];
 
 			if (Emu.IsStopped() || fail_flag)
 			{
@@ -694,7 +773,7 @@ void spu_cache::initialize()
 			}
 
 			// Get data start
-			const u32 start = func.lower_bound;
+			const u32 start = func.entry_point;
 			const u32 size0 = ::size32(func.data);
 
 			be_t<u64> hash_start;
@@ -703,7 +782,7 @@ void spu_cache::initialize()
 				u8 output[20];
 
 				sha1_starts(&ctx);
-				sha1_update(&ctx, reinterpret_cast<const u8*>(func.data.data()), func.data.size() * 4);
+				sha1_update(&ctx, reinterpret_cast<const u8*>(func.data.data()), func.data.size_bytes());
 				sha1_finish(&ctx, output);
 				std::memcpy(&hash_start, output, sizeof(hash_start));
 			}
@@ -725,10 +804,12 @@ void spu_cache::initialize()
 				ls[pos / 4] = std::bit_cast<be_t<u32>>(func.data[i]);
 			}
 
+			const auto time0 = std::chrono::steady_clock::now();
+
 			// Call analyser
 			spu_program func2 = compiler->analyse(ls.data(), func.entry_point);
 
-			if (func2 != func)
+			if (func2.entry_point != func2.lower_bound || !std::equal(func2.data.begin(), func2.data.end(), func.data.begin(), func.data.end()))
 			{
 				spu_log.error("[0x%05x] SPU Analyser failed, %u vs %u", func2.entry_point, func2.data.size(), size0);
 			}
@@ -737,6 +818,10 @@ void spu_cache::initialize()
 				// Likely, out of JIT memory. Signal to prevent further building.
 				fail_flag |= 1;
 			}
+			else
+			{
+				stats.add(std::chrono::steady_clock::now() - time0);
+			}
 
 			// Clear fake LS
 			std::memset(ls.data() + start / 4, 0, 4 * (size0 - 1));
@@ -767,19 +852,20 @@ void spu_cache::initialize()
 
 	if ((g_cfg.core.spu_decoder == spu_decoder_type::asmjit || g_cfg.core.spu_decoder == spu_decoder_type::llvm) && !func_list.empty())
 	{
-		spu_log.success("SPU Runtime: Built %u functions.", func_list.size());
+		spu_log.success("SPU Runtime: Built %u functions (%u loaded from object cache).", func_list.size(), g_fxo->get<spu_runtime>().obj_loaded.load());
+		spu_log.notice("SPU Runtime: Compilation statistics: %s", stats.summary(worker_count));
 
 		if (g_cfg.core.spu_debug)
 		{
 			std::string dump;
 			dump.reserve(10'000'000);
 
-			std::map<std::basic_string_view<u8>, spu_program*> sorted;
+			std::map<std::basic_string_view<u8>, const spu_cache_entry*> sorted;
 
 			for (auto&& f : func_list)
 			{
 				// Interpret as a byte string
-				std::basic_string_view<u8> data = {reinterpret_cast<u8*>(f.data.data()), f.data.size() * sizeof(u32)};
+				std::basic_string_view<u8> data = {reinterpret_cast<const u8*>(f.data.data()), f.data.size_bytes()};
 
 				sorted[data] = &f;
 			}
@@ -872,6 +958,10 @@ void spu_cache::initialize()
 		}
 	}
 
+	// Programs are no longer needed
+	func_list.clear();
+	cache.release_map();
+
 	// Initialize global cache instance
 	if (g_cfg.core.spu_cache)
 	{
@@ -914,6 +1004,110 @@ bool spu_program::operator<(const spu_program& rhs) const noexcept
 	return lhs_offs < rhs_offs;
 }
 
+bool spu_cache::benchmark(const std::string& path, u32 thread_count)
+{
+	spu_cache cache;
+
+	if (!cache.m_file.open(path, fs::read))
+	{
+		spu_log.error("SPU benchmark: failed to open '%s' (%s)", path, fs::g_tls_error);
+		return false;
+	}
+
+	const auto func_list = cache.get();
+
+	if (func_list.empty())
+	{
+		spu_log.error("SPU benchmark: no programs found in '%s'", path);
+		return false;
+	}
+
+	if (g_cfg.core.spu_decoder != spu_decoder_type::asmjit)
+	{
+		g_cfg.core.spu_decoder.set(spu_decoder_type::llvm);
+	}
+
+	if (thread_count)
+	{
+		g_cfg.core.llvm_threads.set(thread_count);
+	}
+
+	// Runtime without object cache (there is no PPU cache location), every program is compiled
+	vm::init();
+	g_fxo->init(false);
+
+	spu_runtime::g_interpreter = spu_runtime::g_gateway;
+
+	const u32 worker_count = rpcs3::utils::get_max_threads();
+
+	jit_compile_stats stats;
+	atomic_t<usz> fnext{};
+	atomic_t<u32> failed{};
+
+	named_thread_group workers("SPU Worker ", worker_count, [&]()
+	{
+#ifdef __APPLE__
+		pthread_jit_write_protect_np(false);
+#endif
+		std::unique_ptr<spu_recompiler_base> compiler;
+
+		if (g_cfg.core.spu_decoder == spu_decoder_type::asmjit)
+		{
+			compiler = spu_recompiler_base::make_asmjit_recompiler();
+		}
+		else
+		{
+			compiler = spu_recompiler_base::make_llvm_recompiler();
+		}
+
+		compiler->init();
+
+		// Fake LS
+		std::vector<be_t<u32>> ls(0x10000);
+
+		for (usz func_i = fnext++; func_i < func_list.size(); func_i = fnext++)
+		{
+			const spu_cache_entry& func = func_list[func_i];
+			const u32 start = func.entry_point;
+			const u32 size0 = ::size32(func.data);
+
+			for (u32 i = 0, pos = start; i < size0; i++, pos += 4)
+			{
+				ls[pos / 4] = std::bit_cast<be_t<u32>>(func.data[i]);
+			}
+
+			const auto time0 = std::chrono::steady_clock::now();
+
+			spu_program func2 = compiler->analyse(ls.data(), func.entry_point);
+
+			if (func2.entry_point != func2.lower_bound || !std::equal(func2.data.begin(), func2.data.end(), func.data.begin(), func.data.end()) || !compiler->compile(std::move(func2)))
+			{
+				failed++;
+			}
+			else
+			{
+				stats.add(std::chrono::steady_clock::now() - time0);
+			}
+
+			std::memset(ls.data() + start / 4, 0, 4 * size0);
+		}
+	});
+
+	workers.join();
+
+	std::string report = fmt::format("SPU %s compilation benchmark: %s (%u programs)\n  %s", g_cfg.core.spu_decoder.get(), path, func_list.size(), stats.summary(worker_count));
+
+	if (failed)
+	{
+		fmt::append(report, "\n  Failed: %u programs", failed.load());
+	}
+
+	spu_log.success("%s", report);
+	std::fprintf(stdout, "%s\n", report.c_str());
+	std::fflush(stdout);
+	return true;
+}
+
 spu_runtime::spu_runtime()
 {
 	// Clear LLVM output
@@ -932,6 +1126,73 @@ spu_runtime::spu_runtime()
 		fs::file(m_cache_path + "spu.log", fs::rewrite);
 		fs::file(m_cache_path + "spu-ir.log", fs::rewrite);
 	}
+
+	if (!g_cfg.core.spu_cache || g_cfg.core.spu_decoder != spu_decoder_type::llvm)
+	{
+		return;
+	}
+
+	// Settings: should be populated by settings which affect codegen
+	enum class spu_settings : u32
+	{
+		non_win32,
+		verification,
+		profiler,
+		loop_detection,
+		accurate_dma,
+		accurate_dfma,
+		accurate_xfloat,
+		approx_xfloat,
+		relaxed_xfloat,
+		full_width_avx512,
+		mfc_debug,
+		fifo_accuracy,
+		strict_rendering,
+		use_rtm,
+
+		__bitset_enum_max
+	};
+
+	be_t<bs_t<spu_settings>> settings{};
+
+#ifndef _WIN32
+	settings += spu_settings::non_win32;
+#endif
+	if (g_cfg.core.spu_verification)
+		settings += spu_settings::verification;
+	if (g_cfg.core.spu_prof)
+		settings += spu_settings::profiler;
+	if (g_cfg.core.spu_loop_detection)
+		settings += spu_settings::loop_detection;
+	if (g_cfg.core.spu_accurate_dma)
+		settings += spu_settings::accurate_dma;
+	if (g_cfg.core.use_accurate_dfma)
+		settings += spu_settings::accurate_dfma;
+	if (g_cfg.core.spu_accurate_xfloat)
+		settings += spu_settings::accurate_xfloat;
+	if (g_cfg.core.spu_approx_xfloat)
+		settings += spu_settings::approx_xfloat;
+	if (g_cfg.core.spu_relaxed_xfloat)
+		settings += spu_settings::relaxed_xfloat;
+	if (g_cfg.core.full_width_avx512)
+		settings += spu_settings::full_width_avx512;
+	if (g_cfg.core.mfc_debug)
+		settings += spu_settings::mfc_debug;
+	if (g_cfg.core.rsx_fifo_accuracy)
+		settings += spu_settings::fifo_accuracy;
+	if (g_cfg.video.strict_rendering_mode)
+		settings += spu_settings::strict_rendering;
+	if (g_use_rtm)
+		settings += spu_settings::use_rtm;
+
+	// Object cache directory (version, block size, settings, CPU)
+	m_obj_path = fmt::format("%sspu-obj-v1-%s-%s-%s/", m_cache_path, fmt::to_lower(g_cfg.core.spu_block_size.to_string()), fmt::base57(settings), jit_compiler::cpu(g_cfg.core.llvm_cpu));
+
+	if (!fs::create_path(m_obj_path))
+	{
+		spu_log.error("Failed to create SPU object cache directory: %s (%s)", m_obj_path, fs::g_tls_error);
+		m_obj_path.clear();
+	}
 }
 
 spu_item* spu_runtime::add_empty(spu_program&& data)
@@ -5519,13 +5780,26 @@ public:
 		pm.add(createAggressiveDCEPass());
 		//pm.add(createLintPass()); // Check
 
+		// Object file is going to be loaded from the cache, skip optimizations
+		const bool is_cached = !m_spurt->get_obj_path().empty() && jit_compiler::check(m_spurt->get_obj_path() + m_hash + ".obj");
+
 		for (auto& f : *m_module)
 		{
+			if (is_cached)
+			{
+				break;
+			}
+
 			replace_intrinsics(f);
 		}
 
 		for (const auto& func : m_functions)
 		{
+			if (is_cached)
+			{
+				break;
+			}
+
 			const auto f = func.second.fn ? func.second.fn : func.second.chunk;
 			pm.run(*f);
 
@@ -5590,7 +5864,12 @@ public:
 		pthread_jit_write_protect_np(false);
 #endif
 
-		if (g_cfg.core.spu_debug)
+		if (!m_spurt->get_obj_path().empty())
+		{
+			// Load the object if it exists, otherwise compile and store it
+			m_jit.add(std::move(_module), m_spurt->get_obj_path());
+		}
+		else if (g_cfg.core.spu_debug)
 		{
 			// Testing only
 			m_jit.add(std::move(_module), m_spurt->get_cache_path() + "llvm/");
@@ -5631,7 +5910,11 @@ public:
 		asm("DSB ISH");
 #endif
 
-		if (g_fxo->get<spu_cache>().operator bool())
+		if (is_cached)
+		{
+			m_spurt->obj_loaded++;
+		}
+		else if (g_fxo->get<spu_cache>().operator bool())
 		{
 			spu_log.success("New block compiled successfully");
 		}
@@ -8,12 +8,29 @@
 #include <memory>
 #include <string>
 #include <deque>
+#include <span>
+
+// SPU program stored in the cache file (data points into the mapped file)
+struct spu_cache_entry
+{
+	// Address of the entry point and the data in LS
+	u32 entry_point;
+
+	// Program data with intentionally wrong endianness (see spu_program)
+	std::span<const u32> data;
+};
 
 // Helper class
 class spu_cache
 {
 	fs::file m_file;
 
+	// Mapped file contents (valid until release_map)
+	fs::file_map m_map;
+
+	// Size of valid records (the rest is truncated on release_map)
+	u64 m_valid_size = umax;
+
 public:
 	spu_cache() = default;
 
@@ -30,11 +47,18 @@ public:
 		return m_file.operator bool();
 	}
 
-	std::deque<struct spu_program> get();
+	// Map the file and return valid programs (without duplicates) in reverse order of addition
+	std::vector<spu_cache_entry> get();
+
+	// Unmap the file, invalidates entries returned by get()
+	void release_map();
 
 	void add(const struct spu_program& func);
 
 	static void initialize();
+
+	// Compile all programs of a cache file without running anything and report statistics (--jit-bench)
+	static bool benchmark(const std::string& path, u32 thread_count);
 };
 
 struct spu_program
@@ -87,6 +111,9 @@ class spu_runtime
 	// Debug module output location
 	std::string m_cache_path;
 
+	// Persistent object cache location (empty if disabled)
+	std::string m_obj_path;
+
 public:
 	// Trampoline to spu_recompiler_base::dispatch
 	static const spu_function_t tr_dispatch;
@@ -112,6 +139,14 @@ public:
 		return m_cache_path;
 	}
 
+	const std::string& get_obj_path() const
+	{
+		return m_obj_path;
+	}
+
+	// Number of functions loaded from the object cache
+	atomic_t<u32> obj_loaded = 0;
+
 	// Rebuild ubertrampoline for given identifier (first instruction)
 	spu_function_t rebuild_ubertrampoline(u32 id_inst);
 
@@ -9,6 +9,7 @@
 #include "Emu/VFS.h"
 #include "Emu/IdManager.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/trace_events.hpp"
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Cell/PPUThread.h"
 #include "Emu/Cell/ErrorCodes.h"
@@ -1419,6 +1420,25 @@ void spu_thread::cpu_return()
 
 extern thread_local std::string(*g_tls_log_prefix)();
 
+// Get SPU thread name for log prefix (cached in thread-local storage)
+static const std::string& spu_get_name_cached(spu_thread* cpu)
+{
+	static thread_local shared_ptr<std::string> name_cache;
+
+	if (!cpu->spu_tname.is_equal(name_cache)) [[unlikely]]
+	{
+		cpu->spu_tname.peek_op([&](const shared_ptr<std::string>& ptr)
+		{
+			if (ptr != name_cache)
+			{
+				name_cache = ptr;
+			}
+		});
+	}
+
+	return *name_cache.get();
+}
+
 void spu_thread::cpu_task()
 {
 #ifdef __APPLE__
@@ -1439,24 +1459,18 @@ void spu_thread::cpu_task()
 	g_tls_log_prefix = []
 	{
 		const auto cpu = static_cast<spu_thread*>(get_current_cpu_thread());
-
-		static thread_local shared_ptr<std::string> name_cache;
-
-		if (!cpu->spu_tname.is_equal(name_cache)) [[unlikely]]
-		{
-			cpu->spu_tname.peek_op([&](const shared_ptr<std::string>& ptr)
-			{
-				if (ptr != name_cache)
-				{
-					name_cache = ptr;
-				}
-			});
-		}
-
 		const auto type = cpu->get_type();
-		return fmt::format("%sSPU[0x%07x] Thread (%s) [0x%05x]", type >= spu_type::raw ? type == spu_type::isolated ? "Iso" : "Raw" : "", cpu->lv2_id, *name_cache.get(), cpu->pc);
+		return fmt::format("%sSPU[0x%07x] Thread (%s) [0x%05x]", type >= spu_type::raw ? type == spu_type::isolated ? "Iso" : "Raw" : "", cpu->lv2_id, spu_get_name_cached(cpu), cpu->pc);
 	};
 
+	logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+	{
+		const auto cpu = static_cast<spu_thread*>(get_current_cpu_thread());
+		const auto type = cpu->get_type();
+		const char* type_name = type >= spu_type::raw ? type == spu_type::isolated ? "Iso" : "Raw" : "";
+		prefix.set("%sSPU[0x%07x] Thread (%s) [0x%05x]", type_name, cpu->lv2_id, spu_get_name_cached(cpu), cpu->pc);
+	});
+
 	if (!spurs_addr)
 	{
 		// Evaluate it
@@ -4546,11 +4560,15 @@ s64 spu_thread::get_ch_value(u32 ch)
 {
 	if (ch < 128) spu_log.trace("get_ch_value(ch=%s)", spu_ch_name[ch]);
 
+	// Blocking channel read
+	trace_scope trace;
+
 	auto read_channel = [&](spu_channel& channel) -> s64
 	{
 		if (channel.get_count() == 0)
 		{
 			state += cpu_flag::wait + cpu_flag::temp;
+			trace.start(trace_category::spu, spu_ch_name[ch]);
 		}
 
 		if (state & cpu_flag::pending)
@@ -4580,6 +4598,7 @@ s64 spu_thread::get_ch_value(u32 ch)
 		if (ch_in_mbox.get_count() == 0)
 		{
 			state += cpu_flag::wait;
+			trace.start(trace_category::spu, spu_ch_name[ch]);
 		}
 
 		while (true)
@@ -5314,6 +5333,8 @@ bool spu_thread::stop_and_signal(u32 code)
 {
 	spu_log.trace("stop_and_signal(code=0x%x)", code);
 
+	trace_scope trace(trace_category::spu, "stop_and_signal");
+
 	auto set_status_npc = [&]()
 	{
 		status_npc.atomic_op([&](status_npc_sync_var& state)
@@ -52,6 +52,9 @@
 #include <optional>
 #include <deque>
 #include "util/tsc.hpp"
+#include "util/sysinfo.hpp"
+
+LOG_CHANNEL(sys_log, "SYS");
 
 extern std::string ppu_get_syscall_name(u64 code);
 
@@ -100,7 +103,7 @@ static void uns_func_(ppu_thread& ppu, ppu_opcode_t, be_t<u32>* this_op, ppu_int
 }
 
 // Bind Syscall
-#define BIND_SYSC(func) {BIND_FUNC(func), #func}
+#define BIND_SYSC(func) {BIND_FUNC_TRACE(trace_category::syscall, func), #func}
 #define NULL_FUNC(name) {null_func_, #name}
 
 constexpr std::pair<ppu_intrp_func_t, std::string_view> null_func{null_func_, ""};
@@ -1203,7 +1206,128 @@ thread_local DECLARE(lv2_obj::g_postpone_notify_barrier){};
 thread_local DECLARE(lv2_obj::g_to_awake);
 
 // Scheduler queue for timeouts (wait until -> thread)
-static std::deque<std::pair<u64, class cpu_thread*>> g_waiting;
+// Binary min-heap, each thread keeps its own index for O(log n) removal
+template <typename T>
+struct lv2_timeout_queue
+{
+	std::vector<std::pair<u64, T*>> heap;
+
+	bool empty() const
+	{
+		return heap.empty();
+	}
+
+	const std::pair<u64, T*>& front() const
+	{
+		return heap.front();
+	}
+
+	void place(usz pos, const std::pair<u64, T*>& entry)
+	{
+		heap[pos] = entry;
+		entry.second->lv2_timeout_index = static_cast<u32>(pos);
+	}
+
+	void sift_up(usz pos)
+	{
+		const auto entry = heap[pos];
+
+		while (pos)
+		{
+			const usz parent = (pos - 1) / 2;
+
+			if (heap[parent].first <= entry.first)
+			{
+				break;
+			}
+
+			place(pos, heap[parent]);
+			pos = parent;
+		}
+
+		place(pos, entry);
+	}
+
+	void sift_down(usz pos)
+	{
+		const auto entry = heap[pos];
+		const usz size = heap.size();
+
+		while (true)
+		{
+			usz child = pos * 2 + 1;
+
+			if (child >= size)
+			{
+				break;
+			}
+
+			if (child + 1 < size && heap[child + 1].first < heap[child].first)
+			{
+				child++;
+			}
+
+			if (entry.first <= heap[child].first)
+			{
+				break;
+			}
+
+			place(pos, heap[child]);
+			pos = child;
+		}
+
+		place(pos, entry);
+	}
+
+	// Insert or reschedule the thread
+	void push(u64 wait_until, T* cpu)
+	{
+		if (const u32 pos = cpu->lv2_timeout_index; pos != umax)
+		{
+			const u64 old = std::exchange(heap[pos].first, wait_until);
+			wait_until < old ? sift_up(pos) : sift_down(pos);
+			return;
+		}
+
+		heap.emplace_back(wait_until, cpu);
+		sift_up(heap.size() - 1);
+	}
+
+	void erase(T* cpu)
+	{
+		const u32 pos = std::exchange(cpu->lv2_timeout_index, umax);
+
+		if (pos == umax)
+		{
+			return;
+		}
+
+		const auto last = heap.back();
+		heap.pop_back();
+
+		if (pos == heap.size())
+		{
+			return;
+		}
+
+		const u64 old = heap[pos].first;
+		place(pos, last);
+		last.first < old ? sift_up(pos) : sift_down(pos);
+	}
+
+	void pop_front()
+	{
+		erase(heap.front().second);
+	}
+
+	void clear()
+	{
+		// Only called on emulation stop, queued threads are not reused afterwards
+		heap.clear();
+	}
+};
+
+static lv2_timeout_queue<cpu_thread> g_waiting;
 
 // Threads which must call lv2_obj::sleep before the scheduler starts
 static std::deque<class cpu_thread*> g_to_sleep;
@@ -1394,14 +1518,7 @@ bool lv2_obj::sleep_unlocked(cpu_thread& thread, u64 timeout, u64 current_time)
 		const u64 wait_until = start_time + std::min<u64>(timeout, ~start_time);
 
 		// Register timeout if necessary
-		for (auto it = g_waiting.cbegin(), end = g_waiting.cend();; it++)
-		{
-			if (it == end || it->first > wait_until)
-			{
-				g_waiting.emplace(it, wait_until, &thread);
-				break;
-			}
-		}
+		g_waiting.push(wait_until, &thread);
 	}
 
 	return return_val;
@@ -1516,14 +1633,7 @@ bool lv2_obj::awake_unlocked(cpu_thread* cpu, s32 prio)
 		}
 
 		// Unregister timeout if necessary
-		for (auto it = g_waiting.cbegin(), end = g_waiting.cend(); it != end; it++)
-		{
-			if (it->second == cpu)
-			{
-				g_waiting.erase(it);
-				break;
-			}
-		}
+		g_waiting.erase(cpu);
 
 		ppu_log.trace("awake(): %s", cpu->id);
 		return true;
@@ -1591,6 +1701,216 @@ void lv2_obj::cleanup()
 	s_yield_frequency = 0;
 }
 
+bool lv2_obj::timeout_queue_benchmark(u32 max_threads)
+{
+	// Stand-in for cpu_thread, only the queue index is used
+	struct bench_thread
+	{
+		u32 lv2_timeout_index = umax;
+	};
+
+	// Each operation is sleep or awake of a random thread, the clock advances and expired timeouts are popped
+	constexpr u32 op_count = 1u << 18;
+
+	std::string report = fmt::format("Scheduler timeout queue benchmark (%u sleep/awake operations per size)", op_count);
+
+	for (u32 thread_count = 16; thread_count <= std::clamp<u32>(max_threads, 16, 1u << 20); thread_count *= 4)
+	{
+		std::vector<bench_thread> threads(thread_count);
+
+		// Returns operations per second
+		const auto run = [&](auto&& sleep, auto&& awake, auto&& pop_expired)
+		{
+			u64 rng = 0x9e3779b97f4a7c15;
+			u64 now = 0;
+
+			const auto start = std::chrono::steady_clock::now();
+
+			for (u32 i = 0; i < op_count; i++, now++)
+			{
+				rng ^= rng << 13, rng ^= rng >> 7, rng ^= rng << 17;
+
+				bench_thread& thread = threads[rng % thread_count];
+
+				if (thread.lv2_timeout_index != umax)
+				{
+					awake(thread);
+				}
+				else
+				{
+					sleep(thread, now + 1 + (rng >> 32) % (thread_count * 4));
+				}
+
+				pop_expired(now);
+			}
+
+			const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			for (bench_thread& thread : threads)
+			{
+				thread.lv2_timeout_index = umax;
+			}
+
+			return op_count / std::max(sec, 1e-9);
+		};
+
+		lv2_timeout_queue<bench_thread> heap;
+
+		const double heap_ops = run([&](bench_thread& thread, u64 wait_until)
+		{
+			heap.push(wait_until, &thread);
+		}, [&](bench_thread& thread)
+		{
+			heap.erase(&thread);
+		}, [&](u64 now)
+		{
+			while (!heap.empty() && heap.front().first <= now)
+			{
+				heap.pop_front();
+			}
+		});
+
+		// Previous implementation: sorted deque with linear insertion and removal (index is only used as a flag)
+		std::deque<std::pair<u64, bench_thread*>> list;
+
+		const double list_ops = run([&](bench_thread& thread, u64 wait_until)
+		{
+			for (auto it = list.cbegin(), end = list.cend();; it++)
+			{
+				if (it == end || it->first > wait_until)
+				{
+					list.emplace(it, wait_until, &thread);
+					break;
+				}
+			}
+
+			thread.lv2_timeout_index = 0;
+		}, [&](bench_thread& thread)
+		{
+			for (auto it = list.cbegin(), end = list.cend(); it != end; it++)
+			{
+				if (it->second == &thread)
+				{
+					list.erase(it);
+					break;
+				}
+			}
+
+			thread.lv2_timeout_index = umax;
+		}, [&](u64 now)
+		{
+			while (!list.empty() && list.front().first <= now)
+			{
+				list.front().second->lv2_timeout_index = umax;
+				list.pop_front();
+			}
+		});
+
+		fmt::append(report, "\n  %5u threads: heap %.2f Mops/s, sorted deque %.2f Mops/s", thread_count, heap_ops / 1e6, list_ops / 1e6);
+	}
+
+	sys_log.success("%s", report);
+	std::fprintf(stdout, "%s\n", report.c_str());
+	std::fflush(stdout);
+	return true;
+}
+
+bool lv2_obj::idm_lookup_benchmark(u32 max_threads)
+{
+	// Same lookups as semaphore syscalls
+	constexpr u32 obj_count = 64;
+	constexpr u32 op_count = 1u << 20;
+
+	vm::init();
+	g_fxo->init(false);
+
+	std::vector<u32> ids;
+
+	for (u32 i = 0; i < obj_count; i++)
+	{
+		ids.push_back(idm::make<lv2_obj, lv2_sema>(SYS_SYNC_PRIORITY, 0, 0, 1, 0));
+	}
+
+	std::string report = fmt::format("IDM lookup benchmark (%u lv2_sema objects, %u idm::check + idm::get per thread)", obj_count, op_count);
+	bool success = true;
+
+	if (!max_threads)
+	{
+		max_threads = utils::get_thread_count();
+	}
+
+	for (u32 thread_count = 1; thread_count <= std::clamp<u32>(max_threads, 1, 128); thread_count *= 2)
+	{
+		// Returns total lookups per second
+		const auto run = [&](auto&& lookup)
+		{
+			atomic_t<u64> found{};
+
+			const auto start = std::chrono::steady_clock::now();
+
+			named_thread_group workers("IDM Bench ", thread_count, [&]()
+			{
+				u64 count = 0;
+
+				for (u32 i = 0; i < op_count; i++)
+				{
+					count += lookup(ids[i % obj_count]);
+				}
+
+				found += count;
+			});
+
+			workers.join();
+
+			const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			if (found != u64{op_count} * thread_count * 2)
+			{
+				success = false;
+			}
+
+			return u64{op_count} * thread_count * 2 / std::max(sec, 1e-9);
+		};
+
+		const double lockfree_ops = run([](u32 id)
+		{
+			return u32{!!idm::check<lv2_obj, lv2_sema>(id)} + !!idm::get<lv2_obj, lv2_sema>(id);
+		});
+
+		// Previous implementation: reader lock on the global mutex
+		const double locked_ops = run([](u32 id)
+		{
+			u32 count = 0;
+			{
+				reader_lock lock(id_manager::g_mutex);
+				count += !!idm::check_unlocked<lv2_obj, lv2_sema>(id);
+			}
+			{
+				reader_lock lock(id_manager::g_mutex);
+				count += !!idm::get_unlocked<lv2_obj, lv2_sema>(id);
+			}
+			return count;
+		});
+
+		fmt::append(report, "\n  %3u threads: lock-free %.2f M/s, g_mutex %.2f M/s", thread_count, lockfree_ops / 1e6, locked_ops / 1e6);
+	}
+
+	for (const u32 id : ids)
+	{
+		idm::remove<lv2_obj, lv2_sema>(id);
+	}
+
+	if (!success)
+	{
+		fmt::append(report, "\n  Error: some lookups failed");
+	}
+
+	sys_log.success("%s", report);
+	std::fprintf(stdout, "%s\n", report.c_str());
+	std::fflush(stdout);
+	return success;
+}
+
 void lv2_obj::schedule_all(u64 current_time)
 {
 	usz notify_later_idx = 0;
@@ -1628,16 +1948,16 @@ void lv2_obj::schedule_all(u64 current_time)
 	// Check registered timeouts
 	while (!g_waiting.empty())
 	{
-		const auto pair = &g_waiting.front();
+		const auto pair = g_waiting.front();
 
 		if (!current_time)
 		{
 			current_time = get_guest_system_time();
 		}
 
-		if (pair->first <= current_time)
+		if (pair.first <= current_time)
 		{
-			const auto target = pair->second;
+			const auto target = pair.second;
 			g_waiting.pop_front();
 
 			if (target != cpu_thread::get_current())
@@ -1659,7 +1979,7 @@ void lv2_obj::schedule_all(u64 current_time)
 		}
 		else
 		{
-			// The list is sorted so assume no more timeouts
+			// The earliest timeout is at the front so assume no more timeouts
 			break;
 		}
 	}
@@ -5,6 +5,7 @@
 
 #include "Emu/Cell/PPUModule.h"
 #include "Emu/Cell/PPUThread.h"
+#include "Emu/Cell/timers.hpp"
 #include "Crypto/unedat.h"
 #include "Emu/System.h"
 #include "Emu/VFS.h"
@@ -12,10 +13,15 @@
 #include "Emu/IdManager.h"
 #include "Emu/RSX/Overlays/overlay_utils.h" // for ascii8_to_utf16
 #include "Utilities/StrUtil.h"
+#include "util/asm.hpp"
 
 #include <charconv>
 #include <span>
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 LOG_CHANNEL(sys_fs);
 
 lv2_fs_mount_point g_mp_sys_dev_root;
@@ -206,9 +212,9 @@ lv2_fs_object::lv2_fs_object(utils::serial& ar, bool)
 {
 }
 
-u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
+// Copy data through intermediate buffer (avoid passing vm pointer to a native API)
+static u64 op_read_bounce(const fs::file& file, uchar* dst, u64 size)
 {
-	// Copy data from intermediate buffer (avoid passing vm pointer to a native API)
 	uchar local_buf[65536];
 
 	u64 result = 0;
@@ -218,7 +224,7 @@ u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
 		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
 		const u64 nread = file.read(+local_buf, block);
 
-		std::memcpy(static_cast<uchar*>(buf.get_ptr()) + result, local_buf, nread);
+		std::memcpy(dst + result, local_buf, nread);
 		result += nread;
 
 		if (nread < block)
@@ -230,9 +236,8 @@ u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
 	return result;
 }
 
-u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
+static u64 op_write_bounce(const fs::file& file, const uchar* src, u64 size)
 {
-	// Copy data to intermediate buffer (avoid passing vm pointer to a native API)
 	uchar local_buf[65536];
 
 	u64 result = 0;
@@ -240,7 +245,7 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 	while (result < size)
 	{
 		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
-		std::memcpy(local_buf, static_cast<const uchar*>(buf.get_ptr()) + result, block);
+		std::memcpy(local_buf, src + result, block);
 		const u64 nwrite = file.write(+local_buf, block);
 		result += nwrite;
 
@@ -253,6 +258,179 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 	return result;
 }
 
+u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
+{
+	uchar* const dst = static_cast<uchar*>(buf.get_ptr());
+
+#ifdef __linux__
+	const int fd = file.get_handle();
+
+	// Read directly into guest memory if the file is native and the whole range is mapped
+	// Linux returns a short count if a protected page is hit after some data has been transferred, other systems may fail with the file offset advanced
+	if (fd >= 0 && size && size <= u32{umax} && vm::check_addr(buf.addr(), vm::page_writable, static_cast<u32>(size)))
+	{
+		u64 result = 0;
+
+		while (result < size)
+		{
+			const auto nread = ::read(fd, dst + result, std::min<u64>(size - result, 0x7fff'f000));
+
+			if (nread > 0)
+			{
+				result += nread;
+				continue;
+			}
+
+			if (nread == 0)
+			{
+				break;
+			}
+
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			// Host page is protected (EFAULT), copy this block the slow way so the access violation handler sees it
+			const u64 block = std::min<u64>(size - result, 65536);
+			const u64 nbounce = op_read_bounce(file, dst + result, block);
+			result += nbounce;
+
+			if (nbounce < block)
+			{
+				break;
+			}
+		}
+
+		return result;
+	}
+#endif
+
+	return op_read_bounce(file, dst, size);
+}
+
+u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
+{
+	const uchar* const src = static_cast<const uchar*>(buf.get_ptr());
+
+#ifdef __linux__
+	const int fd = file.get_handle();
+
+	// Write directly from guest memory if the file is native and the whole range is mapped (see op_read)
+	if (fd >= 0 && size && size <= u32{umax} && vm::check_addr(buf.addr(), vm::page_readable, static_cast<u32>(size)))
+	{
+		u64 result = 0;
+
+		while (result < size)
+		{
+			const auto nwrite = ::write(fd, src + result, std::min<u64>(size - result, 0x7fff'f000));
+
+			if (nwrite > 0)
+			{
+				result += nwrite;
+				continue;
+			}
+
+			if (nwrite < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			// Host page is protected (EFAULT) or the write failed, retry this block through the intermediate buffer
+			const u64 block = std::min<u64>(size - result, 65536);
+			const u64 nbounce = op_write_bounce(file, src + result, block);
+			result += nbounce;
+
+			if (nbounce < block)
+			{
+				break;
+			}
+		}
+
+		return result;
+	}
+#endif
+
+	return op_write_bounce(file, src, size);
+}
+
+bool lv2_file::read_benchmark(const std::string& path, u32 block_size)
+{
+	const fs::file file(path);
+
+	if (!file)
+	{
+		sys_fs.error("Read benchmark: failed to open '%s' (%s)", path, fs::g_tls_error);
+		return false;
+	}
+
+	const u64 file_size = file.size();
+	block_size = std::clamp<u32>(utils::align<u32>(block_size, 4096), 4096, 0x1000'0000);
+
+	// Repeat small files to reduce timer noise
+	const u64 rounds = std::clamp<u64>((u64{1} << 30) / std::max<u64>(file_size, 1), 1, 1000);
+
+	vm::init();
+
+	const u32 addr = vm::alloc(block_size, vm::main);
+
+	if (!addr)
+	{
+		sys_fs.error("Read benchmark: failed to allocate 0x%x bytes of guest memory", block_size);
+		vm::close();
+		return false;
+	}
+
+	const vm::ptr<void> buf = vm::cast(addr);
+
+	std::string report = fmt::format("sys_fs sequential read benchmark: %s (%u bytes x %u, %u bytes per read)", path, file_size, rounds, block_size);
+
+	// First pass warms the host page cache
+	for (u32 pass = 0; pass < 2; pass++)
+	{
+		for (const bool direct : {true, false})
+		{
+			u64 total = 0;
+			u64 calls = 0;
+
+			const u64 start = get_system_time();
+
+			for (u64 i = 0; i < rounds; i++)
+			{
+				file.seek(0);
+
+				while (true)
+				{
+					const u64 nread = direct ? op_read(file, buf, block_size) : op_read_bounce(file, static_cast<uchar*>(buf.get_ptr()), block_size);
+					total += nread;
+					calls++;
+
+					if (nread < block_size)
+					{
+						break;
+					}
+				}
+			}
+
+			const double seconds = std::max<u64>(get_system_time() - start, 1) / 1'000'000.;
+
+			if (pass)
+			{
+				fmt::append(report, "\n  %s: %.1f MiB in %.3fs (%.1f MiB/s, %.2fus per read)", direct ? "lv2_file::op_read" : "Intermediate buffer",
+					total / 1048576., seconds, total / 1048576. / seconds, seconds * 1'000'000. / calls);
+			}
+		}
+	}
+
+	vm::dealloc(addr, vm::main);
+	vm::close();
+
+	sys_fs.success("%s", report);
+	std::fprintf(stdout, "%s\n", report.c_str());
+	std::fflush(stdout);
+	return true;
+}
+
 lv2_file::lv2_file(utils::serial& ar)
 	: lv2_fs_object(ar, false)
 	, mode(ar)
@@ -271,7 +271,7 @@ struct lv2_file final : lv2_fs_object
 	static open_raw_result_t open_raw(const std::string& path, s32 flags, s32 mode, lv2_file_type type = lv2_file_type::regular, const lv2_fs_mount_point* mp = nullptr);
 	static open_result_t open(std::string_view vpath, s32 flags, s32 mode, const void* arg = {}, u64 size = 0);
 
-	// File reading with intermediate buffer
+	// File reading, directly into guest memory when possible
 	static u64 op_read(const fs::file& file, vm::ptr<void> buf, u64 size);
 
 	u64 op_read(vm::ptr<void> buf, u64 size) const
@@ -279,7 +279,7 @@ struct lv2_file final : lv2_fs_object
 		return op_read(file, buf, size);
 	}
 
-	// File writing with intermediate buffer
+	// File writing, directly from guest memory when possible
 	static u64 op_write(const fs::file& file, vm::cptr<void> buf, u64 size);
 
 	u64 op_write(vm::cptr<void> buf, u64 size) const
@@ -287,6 +287,9 @@ struct lv2_file final : lv2_fs_object
 		return op_write(file, buf, size);
 	}
 
+	// Sequential read benchmark of a host file into guest memory (--fs-bench)
+	static bool read_benchmark(const std::string& path, u32 block_size);
+
 	// For MSELF support
 	struct file_view;
 
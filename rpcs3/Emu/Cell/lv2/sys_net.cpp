@@ -1237,6 +1237,9 @@ error_code sys_net_bnet_close(ppu_thread& ppu, s32 s)
 		sock.reset();
 	}
 
+	// Drop the closed socket from the network thread's poll set
+	g_fxo->get<network_context>().wake_up();
+
 	return CELL_OK;
 }
 
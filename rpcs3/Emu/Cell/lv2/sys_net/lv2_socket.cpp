@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "lv2_socket.h"
+#include "network_context.h"
 
 LOG_CHANNEL(sys_net);
 
@@ -61,6 +62,9 @@ bs_t<lv2_socket::poll_t> lv2_socket::get_events() const
 void lv2_socket::set_poll_event(bs_t<lv2_socket::poll_t> event)
 {
 	events += event;
+
+	// The network thread only polls armed sockets, make it rebuild its poll set
+	g_fxo->get<network_context>().wake_up();
 }
 
 void lv2_socket::poll_queue(std::shared_ptr<ppu_thread> ppu, bs_t<lv2_socket::poll_t> event, std::function<bool(bs_t<lv2_socket::poll_t>)> poll_cb)
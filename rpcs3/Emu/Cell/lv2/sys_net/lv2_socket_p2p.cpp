@@ -124,6 +124,7 @@ s32 lv2_socket_p2p::bind(const sys_net_sockaddr& addr)
 		if (!nc.list_p2p_ports.contains(p2p_port))
 		{
 			nc.list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(p2p_port), std::forward_as_tuple(p2p_port));
+			nc.wake_up();
 		}
 
 		auto& pport = ::at32(nc.list_p2p_ports, p2p_port);
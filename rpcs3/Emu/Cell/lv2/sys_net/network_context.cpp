@@ -3,9 +3,19 @@
 #include "Emu/Cell/Modules/sceNp.h" // for SCE_NP_PORT
 
 #include "network_context.h"
+#include "lv2_socket_native.h"
 #include "Emu/system_config.h"
+#include "Emu/Memory/vm.h"
 #include "sys_net_helpers.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
 LOG_CHANNEL(sys_net);
 
 // Used by RPCN to send signaling packets to RPCN server(for UDP hole punching)
@@ -87,10 +97,63 @@ network_thread::network_thread() noexcept
 {
 	if (g_cfg.net.psn_status == np_psn_status::psn_rpcn)
 		list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(SCE_NP_PORT), std::forward_as_tuple(SCE_NP_PORT));
+
+#ifdef __linux__
+	wakeup_fd[0] = wakeup_fd[1] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#elif !defined(_WIN32)
+	if (::pipe(wakeup_fd) == 0)
+	{
+		for (int fd : wakeup_fd)
+		{
+			::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+			::fcntl(fd, F_SETFD, FD_CLOEXEC);
+		}
+	}
+	else
+	{
+		wakeup_fd[0] = wakeup_fd[1] = -1;
+	}
+#endif
+
+#ifndef _WIN32
+	if (wakeup_fd[0] < 0)
+	{
+		sys_net.error("Failed to create network thread wakeup channel (%d), falling back to polling", get_last_error(false));
+	}
+#endif
 }
 
 network_thread::~network_thread()
 {
+#ifndef _WIN32
+	if (wakeup_fd[0] >= 0)
+	{
+		::close(wakeup_fd[0]);
+	}
+
+	if (wakeup_fd[1] >= 0 && wakeup_fd[1] != wakeup_fd[0])
+	{
+		::close(wakeup_fd[1]);
+	}
+#endif
+}
+
+void network_thread::wake_up()
+{
+#ifndef _WIN32
+	// Only one pending wakeup is needed, the thread rebuilds its whole poll set afterwards
+	if (wakeup_fd[1] >= 0 && !wakeup_pending.exchange(true))
+	{
+		const u64 value = 1;
+		[[maybe_unused]] const auto res = ::write(wakeup_fd[1], &value, sizeof(value));
+	}
+#endif
+}
+
+network_thread& network_thread::operator=(thread_state)
+{
+	wake_up();
+	return *this;
 }
 
 void network_thread::operator()()
@@ -106,16 +169,22 @@ void network_thread::operator()()
 	bool was_connecting[lv2_socket::id_count]{};
 #endif
 
+#ifdef _WIN32
 	::pollfd p2p_fd[lv2_socket::id_count]{};
+#else
+	// Wakeup channel, then P2P ports, then native sockets
+	std::vector<::pollfd> poll_fds;
+	std::vector<u16> p2p_ports;
+
+	// Sockets are re-armed through wake_up(), the timeout is only a safety net
+	const int poll_timeout = wakeup_fd[0] >= 0 ? 100 : 1;
+#endif
 
 	while (thread_ctrl::state() != thread_state::aborting)
 	{
-		// Wait with 1ms timeout
 #ifdef _WIN32
+		// Wait with 1ms timeout
 		windows_poll(fds, ::size32(socklist), 1, connecting);
-#else
-		::poll(fds, socklist.size(), 1);
-#endif
 
 		// Check P2P sockets for incoming packets(timeout could probably be set at 0)
 		{
@@ -132,11 +201,8 @@ void network_thread::operator()()
 
 			if (num_p2p_sockets)
 			{
-#ifdef _WIN32
 				const auto ret_p2p = WSAPoll(p2p_fd, num_p2p_sockets, 1);
-#else
-				const auto ret_p2p = ::poll(p2p_fd, num_p2p_sockets, 1);
-#endif
+
 				if (ret_p2p > 0)
 				{
 					auto fd_index = 0;
@@ -156,6 +222,63 @@ void network_thread::operator()()
 				}
 			}
 		}
+#else
+		poll_fds.clear();
+		p2p_ports.clear();
+		poll_fds.push_back({.fd = wakeup_fd[0], .events = POLLIN, .revents = 0});
+
+		{
+			std::lock_guard lock(list_p2p_ports_mutex);
+			for (const auto& [port, p2p_port] : list_p2p_ports)
+			{
+				poll_fds.push_back({.fd = p2p_port.p2p_socket, .events = POLLIN, .revents = 0});
+				p2p_ports.push_back(port);
+			}
+		}
+
+		const usz native_index = poll_fds.size();
+		poll_fds.insert(poll_fds.end(), fds, fds + socklist.size());
+
+		// Wait for native sockets, P2P ports and wakeups at once
+		const auto ret = ::poll(poll_fds.data(), poll_fds.size(), poll_timeout);
+
+		if (ret < 0 && errno != EINTR)
+		{
+			sys_net.error("Error poll on network sockets: %d", get_last_error(false));
+		}
+
+		if (ret > 0 && poll_fds[0].revents)
+		{
+			u64 buf[8];
+			while (::read(wakeup_fd[0], buf, sizeof(buf)) > 0)
+				;
+
+			// Clear the flag only after draining: a wake_up() which skipped writing in between is covered
+			// by the poll set rebuild below, and any later one writes again and interrupts the next poll
+			wakeup_pending.release(false);
+		}
+
+		if (ret > 0 && !p2p_ports.empty())
+		{
+			std::lock_guard lock(list_p2p_ports_mutex);
+
+			for (usz i = 0; i < p2p_ports.size(); i++)
+			{
+				if (!(poll_fds[i + 1].revents & (POLLIN | POLLRDNORM)))
+				{
+					continue;
+				}
+
+				if (auto found = list_p2p_ports.find(p2p_ports[i]); found != list_p2p_ports.end())
+				{
+					while (found->second.recv_data())
+						;
+				}
+			}
+		}
+
+		std::copy_n(poll_fds.begin() + native_index, socklist.size(), fds);
+#endif
 
 		std::lock_guard lock(s_nw_mutex);
 
@@ -211,3 +334,241 @@ void network_thread::operator()()
 		}
 	}
 }
+
+bool sys_net_loopback_benchmark(u32 iterations)
+{
+	iterations = std::max<u32>(iterations, 1);
+
+	// Throughput rounds: datagrams sent back to back before receiving (kept below the default receive buffer)
+	constexpr u32 latency_size = 64;
+	constexpr u32 batch_size = 4096;
+	constexpr u32 batch_count = 8;
+
+	// Lost datagrams are reported instead of waiting forever
+	constexpr u64 recv_timeout_ns = 1'000'000'000;
+
+	vm::init();
+	g_fxo->init(false);
+	g_fxo->need<network_context>();
+
+	std::string report = fmt::format("Network loopback benchmark (%u round trips of %u bytes, %u rounds of %ux%u bytes)", iterations, latency_size, iterations, batch_count, batch_size);
+	bool success = true;
+
+	const auto run = [&](std::string_view name, const std::shared_ptr<lv2_socket>& src, const std::shared_ptr<lv2_socket>& dst, const sys_net_sockaddr& dst_addr)
+	{
+		atomic_t<u32> signals{};
+		u64 lost = 0;
+
+		// Receive one datagram, waiting for the network thread to report it like a blocking recvfrom syscall does
+		const auto recv = [&](u32 len) -> bool
+		{
+			while (true)
+			{
+				const u32 old = signals;
+
+				{
+					auto lock = dst->lock();
+
+					if (const auto res = dst->recvfrom(0, len, false); res && std::get<0>(*res) >= 0)
+					{
+						return true;
+					}
+
+					dst->poll_queue(nullptr, lv2_socket::poll_t::read, [&](bs_t<lv2_socket::poll_t>)
+					{
+						signals++;
+						signals.notify_one();
+						return true;
+					});
+				}
+
+				const auto start = std::chrono::steady_clock::now();
+
+				while (signals == old)
+				{
+					if (std::chrono::steady_clock::now() - start >= std::chrono::nanoseconds(recv_timeout_ns))
+					{
+						dst->clear_queue(nullptr);
+						return false;
+					}
+
+					signals.wait(old, atomic_wait_timeout{recv_timeout_ns});
+				}
+			}
+		};
+
+		std::vector<u64> times;
+		times.reserve(iterations);
+
+		const std::vector<u8> ping(latency_size, 0x5a);
+
+		for (u32 i = 0; i < iterations; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			if (const auto res = src->sendto(0, ping, dst_addr); !res || *res < 0 || !recv(latency_size))
+			{
+				lost++;
+				continue;
+			}
+
+			times.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+
+		const std::vector<u8> block(batch_size, 0xa5);
+		u64 received = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (u32 i = 0; i < iterations; i++)
+		{
+			u32 sent = 0;
+
+			for (u32 j = 0; j < batch_count; j++)
+			{
+				if (const auto res = src->sendto(0, block, dst_addr); res && *res >= 0)
+				{
+					sent++;
+				}
+			}
+
+			for (u32 j = 0; j < sent; j++)
+			{
+				if (!recv(batch_size))
+				{
+					// Rest of the round is considered lost
+					lost += sent - j;
+					break;
+				}
+
+				received += batch_size;
+			}
+
+			lost += batch_count - sent;
+		}
+
+		const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (times.empty())
+		{
+			fmt::append(report, "\n  %s: no datagram received", name);
+			success = false;
+			return;
+		}
+
+		std::sort(times.begin(), times.end());
+
+		const auto percentile = [&](u32 p)
+		{
+			return times[(times.size() - 1) * p / 100] / 1000.;
+		};
+
+		fmt::append(report, "\n  %s: latency p50=%.1fus p90=%.1fus p99=%.1fus max=%.1fus, throughput %.1f MiB/s (%.0f datagrams/s)", name
+			, percentile(50), percentile(90), percentile(99), times.back() / 1000., received / sec / (1024 * 1024), received / batch_size / sec);
+
+		if (lost)
+		{
+			fmt::append(report, ", lost: %u", lost);
+		}
+	};
+
+	// Sockets are registered in IDM so the network thread polls them like guest sockets
+	std::vector<u32> ids;
+
+	const auto make_socket = [&](std::shared_ptr<lv2_socket> sock) -> std::shared_ptr<lv2_socket>
+	{
+		const u32 id = idm::import_existing<lv2_socket>(sock);
+
+		if (id == id_manager::id_traits<lv2_socket>::invalid)
+		{
+			return nullptr;
+		}
+
+		sock->set_lv2_id(id);
+		ids.push_back(id);
+		return sock;
+	};
+
+	const auto close_sockets = [&]()
+	{
+		for (const u32 id : ids)
+		{
+			if (const auto sock = idm::withdraw<lv2_socket>(id))
+			{
+				sock->close();
+			}
+		}
+
+		ids.clear();
+	};
+
+	// Native UDP sockets on 127.0.0.1 with system assigned ports
+	{
+		std::shared_ptr<lv2_socket> native[2];
+
+		for (auto& sock : native)
+		{
+			auto lv2_native = std::make_shared<lv2_socket_native>(SYS_NET_AF_INET, SYS_NET_SOCK_DGRAM, SYS_NET_IPPROTO_UDP);
+
+			if (lv2_native->create_socket() >= 0)
+			{
+				sock = make_socket(std::move(lv2_native));
+			}
+		}
+
+		sys_net_sockaddr addr{};
+		auto& addr_in = reinterpret_cast<sys_net_sockaddr_in&>(addr);
+		addr_in.sin_len = sizeof(sys_net_sockaddr_in);
+		addr_in.sin_family = SYS_NET_AF_INET;
+		addr_in.sin_addr = 0x7f000001;
+
+		if (native[0] && native[1] && native[0]->bind(addr) == CELL_OK && native[1]->bind(addr) == CELL_OK)
+		{
+			run("Native UDP", native[0], native[1], native[1]->getsockname().second);
+		}
+		else
+		{
+			fmt::append(report, "\n  Native UDP: failed to create sockets (%d)", get_last_error(false));
+			success = false;
+		}
+
+		close_sockets();
+	}
+
+	// P2P sockets on two virtual ports of the same P2P port
+	{
+		std::shared_ptr<lv2_socket> p2p[2];
+
+		for (auto& sock : p2p)
+		{
+			sock = make_socket(std::make_shared<lv2_socket_p2p>(SYS_NET_AF_INET, SYS_NET_SOCK_DGRAM_P2P, SYS_NET_IPPROTO_IP));
+		}
+
+		sys_net_sockaddr addr{};
+		auto& addr_p2p = reinterpret_cast<sys_net_sockaddr_in_p2p&>(addr);
+		addr_p2p.sin_len = sizeof(sys_net_sockaddr_in);
+		addr_p2p.sin_family = SYS_NET_AF_INET;
+		addr_p2p.sin_port = SCE_NP_PORT;
+
+		if (p2p[0] && p2p[1] && p2p[0]->bind(addr) == CELL_OK && p2p[1]->bind(addr) == CELL_OK)
+		{
+			// Bound to 0.0.0.0, send to loopback
+			sys_net_sockaddr dst = p2p[1]->getsockname().second;
+			reinterpret_cast<sys_net_sockaddr_in_p2p&>(dst).sin_addr = 0x7f000001;
+
+			run("P2P", p2p[0], p2p[1], dst);
+		}
+		else
+		{
+			fmt::append(report, "\n  P2P: failed to bind port %d", +SCE_NP_PORT);
+			success = false;
+		}
+
+		close_sockets();
+	}
+
+	sys_net.success("%s", report);
+	std::fprintf(stdout, "%s\n", report.c_str());
+	std::fflush(stdout);
+	return success;
+}
@@ -15,6 +15,12 @@ struct network_thread
 	shared_mutex list_p2p_ports_mutex;
 	std::map<u16, nt_p2p_port> list_p2p_ports{};
 
+#ifndef _WIN32
+	// Read and write ends of the wakeup channel (same eventfd on Linux)
+	int wakeup_fd[2]{-1, -1};
+	atomic_t<bool> wakeup_pending = false;
+#endif
+
 	static constexpr auto thread_name = "Network Thread";
 
 	network_thread() noexcept;
@@ -22,6 +28,14 @@ struct network_thread
 	~network_thread();
 
 	void operator()();
+
+	// Interrupt the wait so the thread picks up new poll events or P2P ports
+	void wake_up();
+
+	network_thread& operator=(thread_state);
 };
 
 using network_context = named_thread<network_thread>;
+
+// Measure datagram latency and throughput over loopback for native and P2P sockets through the network thread (--net-bench)
+bool sys_net_loopback_benchmark(u32 iterations);
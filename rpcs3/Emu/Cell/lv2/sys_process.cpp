@@ -424,7 +424,13 @@ void _sys_process_exit2(ppu_thread& ppu, s32 status, vm::ptr<sys_exit2_param> ar
 		auto func = [old_size = g_fxo->get<lv2_memory_container>().size, vec = (reader_lock{g_mutex}, g_fxo->get<id_map<lv2_memory_container>>().vec)](u32 sdk_suggested_mem) mutable
 		{
 			// Save LV2 memory containers
-			g_fxo->init<id_map<lv2_memory_container>>()->vec = std::move(vec);
+			{
+				std::lock_guard lock(g_mutex);
+
+				auto& map = *g_fxo->init<id_map<lv2_memory_container>>();
+				map.vec = std::move(vec);
+				map.publish_all();
+			}
 
 			// Empty the containers, accumulate their total size
 			u32 total_size = 0;
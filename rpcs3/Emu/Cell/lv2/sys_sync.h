@@ -260,6 +260,12 @@ public:
 
 	static void cleanup();
 
+	// Measure sleep/awake throughput of the timeout queue for up to max_threads waiting threads (--sched-bench)
+	static bool timeout_queue_benchmark(u32 max_threads);
+
+	// Measure idm::check/idm::get throughput on lv2 objects with up to max_threads readers (--idm-bench)
+	static bool idm_lookup_benchmark(u32 max_threads);
+
 	template <typename T>
 	static inline u64 get_key(const T& attr)
 	{
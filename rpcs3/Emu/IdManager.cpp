@@ -7,6 +7,109 @@ shared_mutex id_manager::g_mutex;
 namespace id_manager
 {
 	thread_local u32 g_id = 0;
+
+	// Reader slot for epoch based reclamation (one per thread, on its own cache line)
+	struct alignas(64) reader_slot
+	{
+		atomic_t<u64> epoch{0}; // Epoch observed on entry, 0 if not reading
+		atomic_t<u32> used{0};
+	};
+
+	static reader_slot s_readers[256]{};
+
+	static atomic_t<u64> s_epoch{1};
+
+	// Unpublished entries with the epoch they were retired in (protected by g_mutex)
+	static std::vector<std::pair<u64, published_entry*>> s_retired;
+
+	static thread_local struct reader_state
+	{
+		reader_slot* slot = nullptr;
+		u32 depth = 0;
+		bool failed = false;
+
+		~reader_state()
+		{
+			if (slot)
+			{
+				slot->epoch.release(0);
+				slot->used.release(0);
+			}
+
+			// Lookups from later TLS destructors must not use the released slot (nor take a new one)
+			slot = nullptr;
+			failed = true;
+		}
+	} s_reader;
+}
+
+id_manager::reader_epoch::reader_epoch() noexcept
+{
+	auto& state = s_reader;
+
+	if (!state.slot && !state.failed)
+	{
+		for (auto& slot : s_readers)
+		{
+			if (!slot.used && slot.used.compare_and_swap_test(0, 1))
+			{
+				state.slot = &slot;
+				break;
+			}
+		}
+
+		// Too many threads, use g_mutex from now on
+		state.failed = !state.slot;
+	}
+
+	m_active = state.slot != nullptr;
+
+	if (m_active && state.depth++ == 0)
+	{
+		// Full barrier: entries loaded after this point are not deleted until leaving
+		state.slot->epoch.store(s_epoch.load());
+	}
+}
+
+id_manager::reader_epoch::~reader_epoch()
+{
+	if (m_active && --s_reader.depth == 0)
+	{
+		s_reader.slot->epoch.release(0);
+	}
+}
+
+void id_manager::retire(published_entry* entry)
+{
+	s_retired.emplace_back(s_epoch++, entry);
+
+	if (s_retired.size() < 32)
+	{
+		return;
+	}
+
+	// Find the oldest epoch a reader may still be in
+	u64 min_epoch = umax;
+
+	for (auto& slot : s_readers)
+	{
+		if (const u64 epoch = slot.epoch.load())
+		{
+			min_epoch = std::min(min_epoch, epoch);
+		}
+	}
+
+	// Entries retired before any active reader entered are unreachable
+	std::erase_if(s_retired, [&](const std::pair<u64, published_entry*>& retired)
+	{
+		if (retired.first < min_epoch)
+		{
+			delete retired.second;
+			return true;
+		}
+
+		return false;
+	});
 }
 
 template <>
@@ -242,18 +242,106 @@ namespace id_manager
 		}
 	};
 
+	// Immutable snapshot of an occupied ID slot for lock-free lookups
+	struct published_entry
+	{
+		id_key key;
+		void* ptr;
+		std::weak_ptr<void> ref; // Keeps the control block alive without extending the object lifetime
+	};
+
+	// Read-side critical section for published entries (epoch based reclamation)
+	class reader_epoch
+	{
+		bool m_active;
+
+	public:
+		reader_epoch() noexcept;
+
+		reader_epoch(const reader_epoch&) = delete;
+
+		reader_epoch& operator=(const reader_epoch&) = delete;
+
+		~reader_epoch();
+
+		// False if no reader slot is available (the caller must fall back to g_mutex)
+		explicit operator bool() const
+		{
+			return m_active;
+		}
+	};
+
+	// Delete the unpublished entry once no reader can access it anymore (g_mutex must be locked)
+	void retire(published_entry* entry);
+
 	template <typename T>
 	struct id_map
 	{
 		std::vector<std::pair<id_key, std::shared_ptr<void>>> vec{}, private_copy{};
 		shared_mutex mutex{}; // TODO: Use this instead of global mutex
 
+		// Lock-free lookup entries mirroring vec (modified under g_mutex)
+		std::unique_ptr<atomic_t<published_entry*>[]> published = std::make_unique<atomic_t<published_entry*>[]>(T::id_count);
+
 		id_map()
 		{
 			// Preallocate memory
 			vec.reserve(T::id_count);
 		}
 
+		id_map(const id_map&) = delete;
+
+		id_map& operator=(const id_map&) = delete;
+
+		~id_map()
+		{
+			for (u32 i = 0; i < T::id_count; i++)
+			{
+				delete published[i].exchange(nullptr);
+			}
+		}
+
+		// Update the lookup entry after modifying the slot (g_mutex must be locked)
+		void publish(const std::pair<id_key, std::shared_ptr<void>>& slot)
+		{
+			const usz index = &slot - vec.data();
+			published_entry* entry = slot.second ? new published_entry{slot.first, slot.second.get(), slot.second} : nullptr;
+
+			if (const auto old = published[index].exchange(entry))
+			{
+				retire(old);
+			}
+		}
+
+		// Update all lookup entries after replacing vec (g_mutex must be locked)
+		void publish_all()
+		{
+			for (const auto& slot : vec)
+			{
+				publish(slot);
+			}
+
+			for (usz i = vec.size(); i < T::id_count; i++)
+			{
+				if (const auto old = published[i].exchange(nullptr))
+				{
+					retire(old);
+				}
+			}
+		}
+
+		// Unpublish all entries (g_mutex must be locked)
+		void unpublish_all()
+		{
+			for (u32 i = 0; i < T::id_count; i++)
+			{
+				if (const auto old = published[i].exchange(nullptr))
+				{
+					retire(old);
+				}
+			}
+		}
+
 		// Order it directly before the source type's position
 		static constexpr double savestate_init_pos = std::bit_cast<double>(std::bit_cast<u64>(T::savestate_init_pos) - 1);
 
@@ -294,6 +382,7 @@ namespace id_manager
 
 				obj.first = id_key(id, static_cast<u32>(static_cast<u64>(type_init_pos >> 64)));
 				obj.second = info->load(ar);
+				publish(obj);
 			}
 		}
 
@@ -468,6 +557,40 @@ class idm
 		return nullptr;
 	}
 
+	// Lock-free equivalent of find_index (requires id_manager::reader_epoch)
+	template <typename T, typename Type>
+	static id_manager::published_entry* find_published(u32 index, u32 id)
+	{
+		static_assert(PtrSame<T, Type>, "Invalid ID type combination");
+
+		if (index >= T::id_count)
+		{
+			return nullptr;
+		}
+
+		if (const auto entry = g_fxo->get<id_manager::id_map<T>>().published[index].load())
+		{
+			if (std::is_same<T, Type>::value || entry->key.type() == get_type<Type>())
+			{
+				if (!id_manager::id_traits<Type>::invl_range.second || entry->key.value() == id)
+				{
+					return entry;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Move the object out of the slot (g_mutex must be locked)
+	template <typename T>
+	static std::shared_ptr<void> take(map_data& slot)
+	{
+		std::shared_ptr<void> ptr = std::move(slot.second);
+		g_fxo->get<id_manager::id_map<T>>().publish(slot);
+		return ptr;
+	}
+
 	// Find ID
 	template <typename T, typename Type>
 	static map_data* find_id(u32 id)
@@ -503,6 +626,7 @@ class idm
 
 			if (place->second)
 			{
+				map.publish(*place);
 				return place;
 			}
 		}
@@ -517,7 +641,9 @@ public:
 	static inline void clear()
 	{
 		std::lock_guard lock(id_manager::g_mutex);
-		g_fxo->get<id_manager::id_map<T>>().vec.clear();
+		auto& map = g_fxo->get<id_manager::id_map<T>>();
+		map.unpublish_all();
+		map.vec.clear();
 	}
 
 	// Get last ID (updated in create_id/allocate_id)
@@ -595,10 +721,27 @@ public:
 		return nullptr;
 	}
 
-	// Check the ID
+	// Check the ID (lock-free)
 	template <typename T, typename Get = T>
 	static inline Get* check(u32 id)
 	{
+		const u32 index = get_index<Get>(id);
+
+		if (index >= id_manager::id_traits<Get>::count)
+		{
+			return nullptr;
+		}
+
+		if (id_manager::reader_epoch epoch; epoch) [[likely]]
+		{
+			if (const auto entry = find_published<T, Get>(index, id); entry && !entry->ref.expired())
+			{
+				return static_cast<Get*>(entry->ptr);
+			}
+
+			return nullptr;
+		}
+
 		reader_lock lock(id_manager::g_mutex);
 
 		return check_unlocked<T, Get>(id);
@@ -649,10 +792,28 @@ public:
 		return std::static_pointer_cast<Get>(found->second);
 	}
 
-	// Get the object
+	// Get the object (lock-free)
 	template <typename T, typename Get = T>
 	static inline std::shared_ptr<Get> get(u32 id)
 	{
+		const u32 index = get_index<Get>(id);
+
+		if (index >= id_manager::id_traits<Get>::count)
+		{
+			return nullptr;
+		}
+
+		if (id_manager::reader_epoch epoch; epoch) [[likely]]
+		{
+			if (const auto entry = find_published<T, Get>(index, id))
+			{
+				// Fails if the object is being destroyed
+				return std::static_pointer_cast<Get>(entry->ref.lock());
+			}
+
+			return nullptr;
+		}
+
 		reader_lock lock(id_manager::g_mutex);
 
 		return get_unlocked<T, Get>(id);
@@ -743,7 +904,7 @@ public:
 
 			if (const auto found = find_id<T, Get>(id))
 			{
-				ptr = std::move(found->second);
+				ptr = take<T>(*found);
 			}
 			else
 			{
@@ -765,7 +926,7 @@ public:
 			if (const auto found = find_id<T, Get>(id); found &&
 				(!found->second.owner_before(sptr) && !sptr.owner_before(found->second)))
 			{
-				ptr = std::move(found->second);
+				ptr = take<T>(*found);
 			}
 			else
 			{
@@ -786,13 +947,25 @@ public:
 
 			if (const auto found = find_id<T, Get>(id))
 			{
-				ptr = std::static_pointer_cast<Get>(::as_rvalue(std::move(found->second)));
+				ptr = std::static_pointer_cast<Get>(take<T>(*found));
 			}
 		}
 
 		return ptr;
 	}
 
+	// Remove the ID without locking and return the owning pointer (g_mutex must be locked)
+	template <typename T, typename Get = T>
+	static inline std::shared_ptr<void> withdraw_unlocked(u32 id)
+	{
+		if (const auto found = find_id<T, Get>(id))
+		{
+			return take<T>(*found);
+		}
+
+		return nullptr;
+	}
+
 	// Remove the ID after accessing the object under writer lock, return the object and propagate return value
 	template <typename T, typename Get = T, typename F, typename FRT = std::invoke_result_t<F, Get&>>
 	static inline std::conditional_t<std::is_void_v<FRT>, std::shared_ptr<Get>, return_pair<Get, FRT>> withdraw(u32 id, F&& func)
@@ -813,7 +986,7 @@ public:
 			if constexpr (std::is_void_v<FRT>)
 			{
 				func(*_ptr);
-				return std::static_pointer_cast<Get>(::as_rvalue(std::move(found->second)));
+				return std::static_pointer_cast<Get>(take<T>(*found));
 			}
 			else
 			{
@@ -825,7 +998,7 @@ public:
 					return {{found->second, _ptr}, std::move(ret)};
 				}
 
-				return {std::static_pointer_cast<Get>(::as_rvalue(std::move(found->second))), std::move(ret)};
+				return {std::static_pointer_cast<Get>(take<T>(*found)), std::move(ret)};
 			}
 		}
 
@@ -20,6 +20,8 @@
 #include "util/simd.hpp"
 #include "util/serialization.hpp"
 
+#include "xxhash.h"
+
 LOG_CHANNEL(vm_log, "VM");
 
 void ppu_remove_hle_instructions(u32 addr, u32 size);
@@ -1526,6 +1528,64 @@ namespace vm
 		return 0;
 	}
 
+	void block_t::get_memory_images(std::vector<std::pair<u32, u32>>& images)
+	{
+		auto& m_map = (m.*block_map)();
+
+		for (const auto& [addr, shm] : m_map)
+		{
+			if (flags & preallocated)
+			{
+				const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
+				images.emplace_back(addr + guard_size, shm.first - guard_size * 2);
+			}
+			else
+			{
+				images.emplace_back(addr, ::narrow<u32>(shm.second->size()));
+			}
+		}
+	}
+
+	// Contents of memory images of a savestate by address, used as the base of delta savestates
+	using memory_image_map = std::map<u32, std::vector<u8>>;
+
+	// Cache line hashes of the memory images of the loaded savestate
+	static std::map<u32, std::vector<u64>> s_delta_base;
+	static u64 s_delta_base_id = 0;
+
+	// Active while saving a delta savestate
+	static bool s_save_delta = false;
+
+	// Active while loading a delta savestate
+	static const memory_image_map* s_load_base = nullptr;
+
+	static const std::vector<u64>* get_save_base(u32 addr)
+	{
+		if (!s_save_delta)
+		{
+			return nullptr;
+		}
+
+		const auto found = s_delta_base.find(addr);
+		return found != s_delta_base.end() ? &found->second : nullptr;
+	}
+
+	static const std::vector<u8>* get_load_base(const memory_image_map* image, u32 addr)
+	{
+		if (!image)
+		{
+			return nullptr;
+		}
+
+		const auto found = image->find(addr);
+		return found != image->end() ? &found->second : nullptr;
+	}
+
+	static u64 hash_cache_line(const void* ptr)
+	{
+		return XXH64(ptr, 128, 0);
+	}
+
 	static bool check_cache_line_zero(const void* ptr)
 	{
 		const auto p = reinterpret_cast<const v128*>(ptr);
@@ -1539,18 +1599,21 @@ namespace vm
 		return _7 == v128{};
 	}
 
-	static void save_memory_bytes(utils::serial& ar, const u8* ptr, usz size)
+	// Saves cache lines which differ from the base (zeroes if there is no base)
+	static void save_memory_bytes(utils::serial& ar, const u8* ptr, usz size, const std::vector<u64>* base = nullptr)
 	{
 		AUDIT(ar.is_writing() && !(size % 1024));
 
-		for (; size; ptr += 128 * 8, size -= 128 * 8)
+		for (usz line = 0; size; ptr += 128 * 8, size -= 128 * 8, line += 8)
 		{
 			ar(u8{}); // bitmap of 1024 bytes (bit is 128-byte)
 			u8 bitmap = 0, count = 0;
 
 			for (usz i = 0, end = std::min<usz>(size, 128 * 8); i < end; i += 128)
 			{
-				if (!check_cache_line_zero(ptr + i))
+				const usz index = line + i / 128;
+
+				if (base && index < base->size() ? hash_cache_line(ptr + i) != (*base)[index] : !check_cache_line_zero(ptr + i))
 				{
 					bitmap |= 1u << (i / 128);
 					count++;
@@ -1560,14 +1623,17 @@ namespace vm
 
 			// Patch bitmap with correct value
 			*std::prev(&ar.data.back(), count * 128) = bitmap;
+
+			ar.breathe();
 		}
 	}
 
-	static void load_memory_bytes(utils::serial& ar, u8* ptr, usz size)
+	// Loads cache lines, the ones which were not saved are copied from the base (if exists)
+	static void load_memory_bytes(utils::serial& ar, u8* ptr, usz size, const std::vector<u8>* base = nullptr)
 	{
 		AUDIT(!ar.is_writing() && !(size % 128));
 
-		for (; size; ptr += 128 * 8, size -= 128 * 8)
+		for (usz offs = 0; size; ptr += 128 * 8, size -= 128 * 8, offs += 128 * 8)
 		{
 			const u8 bitmap{ar};
 
@@ -1577,7 +1643,13 @@ namespace vm
 				{
 					ar(std::span(ptr + i, 128));
 				}
+				else if (base && offs + i + 128 <= base->size())
+				{
+					std::memcpy(ptr + i, base->data() + offs + i, 128);
+				}
 			}
+
+			ar.breathe();
 		}
 	}
 
@@ -1601,14 +1673,14 @@ namespace vm
 				if (is_memory_compatible_for_copy_from_executable_optimization(addr, shm.first))
 				{
 					// Revert changes
-					ar.data.resize(ar.seek_end(sizeof(u32) * 2 + sizeof(memory_page)));
+					ar.data.resize(ar.seek_end(sizeof(u32) * 2 + sizeof(memory_page)) - ar.data_offset);
 					vm_log.success("Removed memory block matching the memory of the executable from savestate. (addr=0x%x, size=0x%x)", addr, shm.first);
 					continue;
 				}
 
 				// Save raw binary image
 				const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
-				save_memory_bytes(ar, vm::get_super_ptr<const u8>(addr + guard_size), shm.first - guard_size * 2);
+				save_memory_bytes(ar, vm::get_super_ptr<const u8>(addr + guard_size), shm.first - guard_size * 2, get_save_base(addr + guard_size));
 			}
 			else
 			{
@@ -1683,7 +1755,7 @@ namespace vm
 			{
 				// Load binary image
 				const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
-				load_memory_bytes(ar, vm::get_super_ptr<u8>(addr0 + guard_size), size0 - guard_size * 2);
+				load_memory_bytes(ar, vm::get_super_ptr<u8>(addr0 + guard_size), size0 - guard_size * 2, get_load_base(s_load_base, addr0 + guard_size));
 			}
 		}
 	}
@@ -2025,10 +2097,17 @@ namespace vm
 
 		std::memset(g_range_lock_set, 0, sizeof(g_range_lock_set));
 		g_range_lock_bits = 0;
+
+		s_delta_base.clear();
+		s_delta_base_id = 0;
 	}
 
-	void save(utils::serial& ar)
+	void save(utils::serial& ar, u64 savestate_id, bool delta)
 	{
+		// Cache lines which did not change since the loaded savestate are omitted from delta savestates
+		s_save_delta = delta && s_delta_base_id;
+		ar(savestate_id, s_save_delta ? s_delta_base_id : u64{0});
+
 		// Shared memory lookup, sample address is saved for easy memory copy
 		// Just need one address for this optimization
 		std::vector<std::pair<utils::shm*, u32>> shared;
@@ -2074,7 +2153,8 @@ namespace vm
 
 			// TODO: string_view serialization (even with load function, so the loaded address points to a position of the stream's buffer)
 			ar(shm->size());
-			save_memory_bytes(ar, vm::get_super_ptr<u8>(addr), shm->size());
+			ar(addr);
+			save_memory_bytes(ar, vm::get_super_ptr<u8>(addr), shm->size(), get_save_base(addr));
 		}
 
 		// TODO: Serialize std::vector direcly
@@ -2092,10 +2172,161 @@ namespace vm
 		}
 
 		is_memory_compatible_for_copy_from_executable_optimization(0, 0); // Cleanup internal data
+		s_save_delta = false;
+	}
+
+	extern std::shared_ptr<utils::serial> open_savestate_memory_section(u64 savestate_id);
+
+	// Rebuild the memory images of a savestate (following its chain of delta savestates)
+	static bool load_memory_images(u64 savestate_id, memory_image_map& images, u32 depth = 0)
+	{
+		if (depth >= 256)
+		{
+			vm_log.error("Delta savestates chain is too long (id=0x%x)", savestate_id);
+			return false;
+		}
+
+		const auto ar_ptr = open_savestate_memory_section(savestate_id);
+
+		if (!ar_ptr)
+		{
+			vm_log.error("Failed to find base savestate of delta savestate (id=0x%x)", savestate_id);
+			return false;
+		}
+
+		auto& ar = *ar_ptr;
+
+		const u64 id = ar;
+		const u64 parent_id = ar;
+
+		if (id != savestate_id)
+		{
+			return false;
+		}
+
+		memory_image_map base;
+
+		if (parent_id && !load_memory_images(parent_id, base, depth + 1))
+		{
+			return false;
+		}
+
+		std::vector<std::vector<u8>> shared(ar.operator usz());
+
+		for (auto& data : shared)
+		{
+			[[maybe_unused]] const u32 flags = ar;
+			const u64 size = ar;
+			const u32 addr = ar;
+			data.resize(size);
+			load_memory_bytes(ar, data.data(), data.size(), get_load_base(&base, addr));
+		}
+
+		images.clear();
+
+		for (usz i = 0, count = ar.operator usz(); i < count; i++)
+		{
+			if (!ar.operator u8())
+			{
+				continue;
+			}
+
+			[[maybe_unused]] const u32 addr = ar;
+			[[maybe_unused]] const u32 size = ar;
+			const u64 flags = ar;
+
+			while (true)
+			{
+				const u8 flags0 = ar;
+
+				if (!(flags0 & page_allocated))
+				{
+					break;
+				}
+
+				const u32 addr0 = ar;
+				const u32 size0 = ar;
+
+				if (flags & preallocated)
+				{
+					const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
+					auto& data = images[addr0 + guard_size];
+					data.resize(size0 - guard_size * 2);
+					load_memory_bytes(ar, data.data(), data.size(), get_load_base(&base, addr0 + guard_size));
+				}
+				else
+				{
+					images[addr0] = shared[ar.operator usz()];
+				}
+			}
+		}
+
+		vm_log.notice("Loaded memory images of base savestate (id=0x%x, parent=0x%x)", id, parent_id);
+		return ar.is_valid();
+	}
+
+	// Remember the memory of the loaded savestate for delta savestates
+	static void record_delta_base(u64 savestate_id)
+	{
+		s_delta_base.clear();
+		s_delta_base_id = 0;
+
+		if (!savestate_id || !g_cfg.savestate.delta_savestates)
+		{
+			return;
+		}
+
+		std::vector<std::pair<u32, u32>> images;
+
+		for (auto& loc : g_locations)
+		{
+			if (loc) loc->get_memory_images(images);
+		}
+
+		for (const auto& [addr, size] : images)
+		{
+			auto& hashes = s_delta_base[addr];
+			hashes.resize(size / 128);
+
+			const u8* ptr = vm::get_super_ptr<const u8>(addr);
+
+			for (usz i = 0; i < hashes.size(); i++)
+			{
+				hashes[i] = hash_cache_line(ptr + i * 128);
+			}
+		}
+
+		s_delta_base_id = savestate_id;
+	}
+
+	u64 get_delta_base_id()
+	{
+		return s_delta_base_id;
 	}
 
 	void load(utils::serial& ar)
 	{
+		u64 savestate_id = 0;
+		u64 parent_id = 0;
+
+		if (GET_SERIALIZATION_VERSION(global_version) >= 13)
+		{
+			ar(savestate_id, parent_id);
+		}
+
+		memory_image_map base;
+
+		if (parent_id)
+		{
+			// Delta savestate: memory which is not saved comes from the chain of base savestates
+			if (!load_memory_images(parent_id, base))
+			{
+				fmt::throw_exception("Failed to load the base of delta savestate (id=0x%x, parent=0x%x)", savestate_id, parent_id);
+			}
+
+			s_load_base = &base;
+		}
+
 		std::vector<std::shared_ptr<utils::shm>> shared;
 		shared.resize(ar.operator usz());
 
@@ -2105,11 +2336,12 @@ namespace vm
 
 			const u32 flags = ar;
 			const u64 size = ar;
+			const u32 addr = GET_SERIALIZATION_VERSION(global_version) >= 13 ? ar.operator u32() : 0;
 			shm = std::make_shared<utils::shm>(size, flags);
 
 			// Load binary image
 			// elad335: I'm not proud about it as well.. (ideal situation is to not call map_self())
-			load_memory_bytes(ar, shm->map_self(), shm->size());
+			load_memory_bytes(ar, shm->map_self(), shm->size(), get_load_base(s_load_base, addr));
 		}
 
 		for (auto& block : g_locations)
@@ -2130,6 +2362,11 @@ namespace vm
 			}
 		}
 
+		s_load_base = nullptr;
+		base.clear();
+
+		record_delta_base(savestate_id);
+
 		g_range_lock = 0;
 	}
 
@@ -176,6 +176,9 @@ namespace vm
 		// Returns sample address for shared memory, 0 on failure
 		u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared);
 
+		// Serialization helper for delta savestates, lists (address, size) of memory images
+		void get_memory_images(std::vector<std::pair<u32, u32>>& images);
+
 		// Serialization
 		void save(utils::serial& ar, std::map<utils::shm*, usz>& shared);
 		block_t(utils::serial& ar, std::vector<std::shared_ptr<utils::shm>>& shared);
@@ -347,7 +350,10 @@ namespace vm
 	void close();
 
 	void load(utils::serial& ar);
-	void save(utils::serial& ar);
+	void save(utils::serial& ar, u64 savestate_id = 0, bool delta = false);
+
+	// Returns the ID of the loaded savestate if delta savestates can be based on it, 0 otherwise
+	u64 get_delta_base_id();
 
 	// Returns sample address for shared memory, 0 on failure (wraps block_t::get_shm_addr)
 	u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared);
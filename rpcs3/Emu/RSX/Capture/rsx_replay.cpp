@@ -7,6 +7,9 @@
 #include "Emu/RSX/RSXThread.h"
 
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
+
+#include <cstdio>
 
 namespace rsx
 {
@@ -167,12 +170,45 @@ namespace rsx
 		}
 	}
 
+	void rsx_replay_thread::report_benchmark(u32 iterations, u64 elapsed_us) const
+	{
+		const auto& counters = get_current_renderer()->bench_counters;
+		const double seconds = std::max<u64>(elapsed_us, 1) / 1'000'000.;
+		const double method_ms = counters.method_ticks * 1000. / std::max<u64>(utils::get_tsc_freq(), 1);
+
+		const std::string report = fmt::format(
+			"RSX capture replay benchmark: %u frames in %.3fs (%.2f fps)\n"
+			"  FIFO commands: %u (%.0f/s)\n"
+			"  Method handler time: %.3fms per frame\n"
+			"  Vertex upload: %u bytes per frame\n"
+			"  Index upload: %u bytes per frame\n"
+			"  Texture lookups: %u per frame",
+			iterations, seconds, iterations / seconds,
+			counters.fifo_commands, counters.fifo_commands / seconds,
+			method_ms / iterations,
+			counters.vertex_upload_bytes / iterations,
+			counters.index_upload_bytes / iterations,
+			counters.texture_lookups / iterations);
+
+		rsx_log.success("%s", report);
+		std::fprintf(stdout, "%s\n", report.c_str());
+		std::fflush(stdout);
+	}
+
 	void rsx_replay_thread::cpu_task()
 	{
 		be_t<u32> context_id = allocate_context();
 
 		auto fifo_stops = alloc_write_fifo(context_id);
 
+		if (bench_iterations)
+		{
+			get_current_renderer()->bench_counters.enabled = true;
+		}
+
+		const u64 bench_start = get_system_time();
+		u32 iteration = 0;
+
 		while (!Emu.IsStopped())
 		{
 			// Load registers while the RSX is still idle
@@ -234,8 +270,31 @@ namespace rsx
 				render->request_emu_flip(1u);
 			}
 
-			// random pause to not destroy gpu
-			thread_ctrl::wait_for(10'000);
+			if (!bench_iterations)
+			{
+				// random pause to not destroy gpu
+				thread_ctrl::wait_for(10'000);
+				continue;
+			}
+
+			// Let the frame complete before restarting it
+			while (render->int_flip_index == last_flip && !Emu.IsStopped())
+			{
+				std::this_thread::yield();
+			}
+
+			if (++iteration == bench_iterations && !Emu.IsStopped())
+			{
+				report_benchmark(iteration, get_system_time() - bench_start);
+
+				Emu.CallFromMainThread([]()
+				{
+					Emu.Kill(false);
+					Emu.Quit(true);
+				});
+
+				break;
+			}
 		}
 
 		get_current_cpu_thread()->state += (cpu_flag::exit + cpu_flag::wait);
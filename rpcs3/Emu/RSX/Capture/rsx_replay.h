@@ -142,11 +142,13 @@ namespace rsx
 		u32 user_mem_addr{};
 		current_state cs{};
 		std::unique_ptr<frame_capture_data> frame;
+		u32 bench_iterations = 0; // Replay count in benchmark mode, 0 replays until stopped
 
 	public:
-		rsx_replay_thread(std::unique_ptr<frame_capture_data>&& frame_data)
+		rsx_replay_thread(std::unique_ptr<frame_capture_data>&& frame_data, u32 iterations = 0)
 			: cpu_thread(0)
 			, frame(std::move(frame_data))
+			, bench_iterations(iterations)
 		{
 		}
 
@@ -156,5 +158,6 @@ namespace rsx
 		be_t<u32> allocate_context();
 		std::vector<u32> alloc_write_fifo(be_t<u32> context_id) const;
 		void apply_frame_state(be_t<u32> context_id, const frame_capture_data::replay_command& replay_cmd);
+		void report_benchmark(u32 iterations, u64 elapsed_us) const;
 	};
 }
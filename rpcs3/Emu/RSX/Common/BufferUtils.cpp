@@ -460,6 +460,193 @@ std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::spa
 	}
 }
 
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+	// Shuffle mask gathering the given big endian source indices as host indices (-1 leaves the output index cleared)
+	template <typename T>
+	v128 make_expand_mask(std::initializer_list<s32> indices)
+	{
+		v128 mask = v128::from8p(0x80);
+		u32 pos = 0;
+
+		for (const s32 index : indices)
+		{
+			for (u32 byte = 0; byte < sizeof(T); byte++, pos++)
+			{
+				if (index >= 0)
+				{
+					mask._u8[pos] = static_cast<u8>(index * sizeof(T) + sizeof(T) - 1 - byte);
+				}
+			}
+		}
+
+		return mask;
+	}
+
+	// Lanes cleared by a shuffle mask
+	v128 make_cleared_lanes(const v128& mask)
+	{
+		v128 lanes{};
+
+		for (u32 i = 0; i < 16; i++)
+		{
+			lanes._u8[i] = mask._u8[i] == 0x80 ? 0xff : 0;
+		}
+
+		return lanes;
+	}
+
+	// Two quads (u16) or one quad (u32) per source vector: {0, 1, 2, 2, 3, 0}
+	const v128 s_quads_u16_mask_lo = make_expand_mask<u16>({0, 1, 2, 2, 3, 0, 4, 5});
+	const v128 s_quads_u16_mask_hi = make_expand_mask<u16>({6, 6, 7, 4});
+	const v128 s_quads_u32_mask_lo = make_expand_mask<u32>({0, 1, 2, 2});
+	const v128 s_quads_u32_mask_hi = make_expand_mask<u32>({3, 0});
+
+	// Four triangles (u16) or two triangles (u32) per source window starting at the last emitted index, cleared lanes take the anchor
+	const v128 s_fan_u16_mask_lo = make_expand_mask<u16>({-1, 0, 1, -1, 1, 2, -1, 2});
+	const v128 s_fan_u16_mask_hi = make_expand_mask<u16>({3, -1, 3, 4});
+	const v128 s_fan_u32_mask_lo = make_expand_mask<u32>({-1, 0, 1, -1});
+	const v128 s_fan_u32_mask_hi = make_expand_mask<u32>({1, 2});
+	const v128 s_fan_u16_anchor_lo = make_cleared_lanes(s_fan_u16_mask_lo);
+	const v128 s_fan_u16_anchor_hi = make_cleared_lanes(s_fan_u16_mask_hi);
+	const v128 s_fan_u32_anchor_lo = make_cleared_lanes(s_fan_u32_mask_lo);
+	const v128 s_fan_u32_anchor_hi = make_cleared_lanes(s_fan_u32_mask_hi);
+
+	struct expand_impl
+	{
+		static SSE4_1_FUNC v128 shuffle(const v128& data, const v128& mask)
+		{
+#if defined(ARCH_X64)
+			return _mm_shuffle_epi8(data, mask);
+#else
+			return vqtbl1q_u8(data, mask);
+#endif
+		}
+
+		template <typename T>
+		static SSE4_1_FUNC void update_min_max(v128& vmin, v128& vmax, const v128& value)
+		{
+#if defined(ARCH_X64)
+			if constexpr (sizeof(T) == 2)
+			{
+				vmin = _mm_min_epu16(vmin, value);
+				vmax = _mm_max_epu16(vmax, value);
+			}
+			else
+			{
+				vmin = _mm_min_epu32(vmin, value);
+				vmax = _mm_max_epu32(vmax, value);
+			}
+#else
+			if constexpr (sizeof(T) == 2)
+			{
+				vmin = gv_minu16(vmin, value);
+				vmax = gv_maxu16(vmax, value);
+			}
+			else
+			{
+				vmin = gv_minu32(vmin, value);
+				vmax = gv_maxu32(vmax, value);
+			}
+#endif
+		}
+
+		// Check the vector for indices which need special handling by the scalar path
+		template <typename T>
+		static bool has_index(const v128& value, const v128& index0, const v128& index1)
+		{
+			const v128 r = sizeof(T) == 2 ? gv_or32(gv_eq16(value, index0), gv_eq16(value, index1)) : gv_or32(gv_eq32(value, index0), gv_eq32(value, index1));
+			return (r._u64[0] | r._u64[1]) != 0;
+		}
+
+		template <typename T>
+		static void reduce_min_max(const v128& vmin, const v128& vmax, T& min_index, T& max_index)
+		{
+			for (u32 i = 0; i < 16 / sizeof(T); i++)
+			{
+				const T lo = sizeof(T) == 2 ? vmin._u16[i] : vmin._u32[i];
+				const T hi = sizeof(T) == 2 ? vmax._u16[i] : vmax._u32[i];
+				min_index = std::min(min_index, lo);
+				max_index = std::max(max_index, hi);
+			}
+		}
+
+		// Expand complete quads until the source ends or a restart index is met, returns the number of source indices consumed
+		template <typename T>
+		static SSE4_1_FUNC u32 expand_quads(const be_t<T>* src, T* dst, u32 count, v128& vmin, v128& vmax, bool check_restart, const v128& restart)
+		{
+			constexpr u32 step = 16 / sizeof(T);
+			const v128& mask_lo = sizeof(T) == 2 ? s_quads_u16_mask_lo : s_quads_u32_mask_lo;
+			const v128& mask_hi = sizeof(T) == 2 ? s_quads_u16_mask_hi : s_quads_u32_mask_hi;
+			const v128& bswap = sizeof(T) == 2 ? s_bswap_u16_mask : s_bswap_u32_mask;
+
+			u32 i = 0;
+
+			for (; i + step <= count; i += step, dst += step + step / 2)
+			{
+				v128 data;
+				std::memcpy(&data, src + i, 16);
+
+				const v128 value = shuffle(data, bswap);
+
+				if (check_restart && has_index<T>(value, restart, restart))
+				{
+					break;
+				}
+
+				update_min_max<T>(vmin, vmax, value);
+
+				const v128 lo = shuffle(data, mask_lo);
+				const v128 hi = shuffle(data, mask_hi);
+				std::memcpy(dst, &lo, 16);
+				std::memcpy(dst + step, &hi, 8);
+			}
+
+			return i;
+		}
+
+		// Expand fan triangles from the window starting at the last emitted index, returns the number of new source indices consumed
+		template <typename T>
+		static SSE4_1_FUNC u32 expand_fan(const be_t<T>* window, T* dst, u32 count, T anchor, v128& vmin, v128& vmax, const v128& restart)
+		{
+			constexpr u32 step = 16 / sizeof(T);
+			constexpr u32 advance = step / 2;
+			const v128& mask_lo = sizeof(T) == 2 ? s_fan_u16_mask_lo : s_fan_u32_mask_lo;
+			const v128& mask_hi = sizeof(T) == 2 ? s_fan_u16_mask_hi : s_fan_u32_mask_hi;
+			const v128& bswap = sizeof(T) == 2 ? s_bswap_u16_mask : s_bswap_u32_mask;
+
+			const v128 anchor_vec = sizeof(T) == 2 ? gv_bcst16(anchor) : gv_bcst32(anchor);
+			const v128 anchor_lo = gv_and32(anchor_vec, sizeof(T) == 2 ? s_fan_u16_anchor_lo : s_fan_u32_anchor_lo);
+			const v128 anchor_hi = gv_and32(anchor_vec, sizeof(T) == 2 ? s_fan_u16_anchor_hi : s_fan_u32_anchor_hi);
+			const v128 invalid = v128::from8p(0xff);
+
+			u32 i = 0;
+
+			for (; i + step <= count; i += advance, dst += advance * 3)
+			{
+				v128 data;
+				std::memcpy(&data, window + i, 16);
+
+				const v128 value = shuffle(data, bswap);
+
+				// The invalid index is used as a state marker by the scalar path
+				if (has_index<T>(value, restart, invalid))
+				{
+					break;
+				}
+
+				update_min_max<T>(vmin, vmax, value);
+
+				const v128 lo = gv_or32(shuffle(data, mask_lo), anchor_lo);
+				const v128 hi = gv_or32(shuffle(data, mask_hi), anchor_hi);
+				std::memcpy(dst, &lo, 16);
+				std::memcpy(dst + step, &hi, 8);
+			}
+
+			return i;
+		}
+	};
+#endif
+
 	template<typename T>
 	std::tuple<T, T, u32> expand_indexed_triangle_fan(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
 	{
@@ -476,8 +663,34 @@ std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::spa
 		T anchor = invalid_index;
 		T last_index = invalid_index;
 
-		for (const T index : src)
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		// Restart indices out of range never match, the invalid index already forces the scalar path
+		const T restart_index = is_primitive_restart_enabled && primitive_restart_index <= invalid_index ? static_cast<T>(primitive_restart_index) : invalid_index;
+		const v128 restart_vec = sizeof(T) == 2 ? gv_bcst16(static_cast<u16>(restart_index)) : gv_bcst32(restart_index);
+		v128 vmin = v128::from8p(0xff);
+		v128 vmax{};
+#endif
+
+		for (u32 i = 0, count = ::size32(src); i < count;)
 		{
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+			if (s_use_sse4_1 && !needs_anchor && last_index != invalid_index)
+			{
+				// The last emitted index is the previous source index
+				const u32 done = expand_impl::expand_fan<T>(src.data() + i - 1, dst.data() + dst_idx, count - i + 1, anchor, vmin, vmax, restart_vec);
+
+				if (done)
+				{
+					i += done;
+					dst_idx += done * 3;
+					last_index = src[i - 1];
+					continue;
+				}
+			}
+#endif
+
+			const T index = src[i++];
+
 			if (needs_anchor)
 			{
 				if (is_primitive_restart_enabled && index == primitive_restart_index)
@@ -509,6 +722,10 @@ std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::spa
 			last_index = index;
 		}
 
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		expand_impl::reduce_min_max<T>(vmin, vmax, min_index, max_index);
+#endif
+
 		return std::make_tuple(min_index, max_index, dst_idx);
 	}
 
@@ -524,8 +741,32 @@ std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::spa
 		u8 set_size = 0;
 		T tmp_indices[4];
 
-		for (const T index : src)
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		// Restart indices out of range never match
+		const bool check_restart = is_primitive_restart_enabled && primitive_restart_index <= index_limit<T>();
+		const v128 restart_vec = sizeof(T) == 2 ? gv_bcst16(static_cast<u16>(primitive_restart_index)) : gv_bcst32(primitive_restart_index);
+		v128 vmin = v128::from8p(0xff);
+		v128 vmax{};
+#endif
+
+		for (u32 i = 0, count = ::size32(src); i < count;)
 		{
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+			if (s_use_sse4_1 && set_size == 0)
+			{
+				const u32 done = expand_impl::expand_quads<T>(src.data() + i, dst.data() + dst_idx, count - i, vmin, vmax, check_restart, restart_vec);
+
+				if (done)
+				{
+					i += done;
+					dst_idx += done + done / 2;
+					continue;
+				}
+			}
+#endif
+
+			const T index = src[i++];
+
 			if (is_primitive_restart_enabled && index == primitive_restart_index)
 			{
 				//empty temp buffer
@@ -550,6 +791,10 @@ std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::spa
 			}
 		}
 
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		expand_impl::reduce_min_max<T>(vmin, vmax, min_index, max_index);
+#endif
+
 		return std::make_tuple(min_index, max_index, dst_idx);
 	}
 }
@@ -636,15 +881,49 @@ void write_index_array_for_non_indexed_non_native_primitive_to_buffer(char* dst,
 		return;
 	case rsx::primitive_type::triangle_fan:
 	case rsx::primitive_type::polygon:
-		for (unsigned i = 0; i < (count - 2); i++)
+	{
+		unsigned i = 0;
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		// Four triangles per iteration, anchor lanes are not advanced
+		v128 lo = v128::from64(0x0000'0002'0001'0000, 0x0003'0000'0003'0002);
+		v128 hi = v128::from64(0x0005'0004'0000'0004);
+		const v128 inc_lo = v128::from64(0x0000'0004'0004'0000, 0x0004'0000'0004'0004);
+		const v128 inc_hi = v128::from64(0x0004'0004'0000'0004);
+
+		for (; i + 4 <= (count - 2); i += 4)
+		{
+			std::memcpy(typedDst + 3 * i, &lo, 16);
+			std::memcpy(typedDst + 3 * i + 8, &hi, 8);
+			lo = gv_add16(lo, inc_lo);
+			hi = gv_add16(hi, inc_hi);
+		}
+#endif
+		for (; i < (count - 2); i++)
 		{
 			typedDst[3 * i] = 0;
 			typedDst[3 * i + 1] = i + 2 - 1;
 			typedDst[3 * i + 2] = i + 2;
 		}
 		return;
+	}
 	case rsx::primitive_type::quads:
-		for (unsigned i = 0; i < count / 4; i++)
+	{
+		unsigned i = 0;
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		// Two quads per iteration
+		v128 lo = v128::from64(0x0002'0002'0001'0000, 0x0005'0004'0000'0003);
+		v128 hi = v128::from64(0x0004'0007'0006'0006);
+		const v128 inc = gv_bcst16(8);
+
+		for (; i + 2 <= count / 4; i += 2)
+		{
+			std::memcpy(typedDst + 6 * i, &lo, 16);
+			std::memcpy(typedDst + 6 * i + 8, &hi, 8);
+			lo = gv_add16(lo, inc);
+			hi = gv_add16(hi, inc);
+		}
+#endif
+		for (; i < count / 4; i++)
 		{
 			// First triangle
 			typedDst[6 * i] = 4 * i;
@@ -656,6 +935,7 @@ void write_index_array_for_non_indexed_non_native_primitive_to_buffer(char* dst,
 			typedDst[6 * i + 5] = 4 * i;
 		}
 		return;
+	}
 	case rsx::primitive_type::quad_strip:
 	case rsx::primitive_type::points:
 	case rsx::primitive_type::lines:
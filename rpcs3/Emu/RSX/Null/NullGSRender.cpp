@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "NullGSRender.h"
+#include "Emu/RSX/Common/BufferUtils.h"
 
 u64 NullGSRender::get_cycles()
 {
@@ -12,6 +13,119 @@ NullGSRender::NullGSRender(utils::serial* ar) noexcept : GSRender(ar)
 
 void NullGSRender::end()
 {
-	execute_nop_draw();
+	if (bench_counters.enabled) [[unlikely]]
+	{
+		// Perform the CPU side of a draw so that capture replay benchmarks measure it
+		emulate_geometry_upload();
+	}
+	else
+	{
+		execute_nop_draw();
+	}
+
 	rsx::thread::end();
 }
+
+void NullGSRender::emulate_geometry_upload()
+{
+	auto& draw_call = rsx::method_registers.current_draw_clause;
+
+	for (u32 i = 0; i < 16; i++)
+	{
+		bench_counters.texture_lookups += rsx::method_registers.fragment_textures[i].enabled();
+	}
+
+	for (u32 i = 0; i < 4; i++)
+	{
+		bench_counters.texture_lookups += rsx::method_registers.vertex_textures[i].enabled();
+	}
+
+	draw_call.begin();
+	u32 subdraw = 0;
+
+	do
+	{
+		const rsx::flags32_t vertex_state = (subdraw++ == 0) ? rsx::vertex_arrays_changed : draw_call.execute_pipeline_dependencies();
+
+		if (vertex_state & (rsx::vertex_arrays_changed | rsx::vertex_base_changed))
+		{
+			analyse_inputs_interleaved(m_vertex_layout);
+		}
+
+		if (!m_vertex_layout.validate())
+		{
+			continue;
+		}
+
+		const u32 element_count = draw_call.get_elements_count();
+		u32 min_index = draw_call.min_index();
+		u32 max_index = min_index + element_count - 1;
+		u32 index_bytes = 0;
+
+		switch (draw_call.command)
+		{
+		case rsx::draw_command::array:
+		{
+			if (!is_primitive_native(draw_call.primitive))
+			{
+				index_bytes = get_index_count(draw_call.primitive, element_count) * sizeof(u16);
+				m_index_scratch.resize(std::max<usz>(m_index_scratch.size(), index_bytes));
+				write_index_array_for_non_indexed_non_native_primitive_to_buffer(reinterpret_cast<char*>(m_index_scratch.data()), draw_call.primitive, element_count);
+			}
+
+			break;
+		}
+		case rsx::draw_command::indexed:
+		{
+			const auto type = draw_call.is_immediate_draw ? rsx::index_array_type::u32 : rsx::method_registers.index_type();
+			const u32 index_count = is_primitive_native(draw_call.primitive) ? element_count : get_index_count(draw_call.primitive, element_count);
+
+			index_bytes = index_count * get_index_type_size(type);
+			m_index_scratch.resize(std::max<usz>(m_index_scratch.size(), index_bytes));
+
+			const auto command = std::get<rsx::draw_indexed_array_command>(get_draw_command(rsx::method_registers));
+
+			std::tie(min_index, max_index, std::ignore) = write_index_array_data_to_buffer(
+				{ m_index_scratch.data(), index_bytes },
+				command.raw_index_buffer, type,
+				draw_call.primitive,
+				rsx::method_registers.restart_index_enabled(),
+				rsx::method_registers.restart_index(),
+				[](auto prim) { return !is_primitive_native(prim); });
+
+			if (min_index >= max_index)
+			{
+				continue;
+			}
+
+			// Only upload the referenced vertices
+			const u32 range = max_index - min_index;
+			min_index = rsx::get_index_from_base(min_index, rsx::method_registers.vertex_data_base_index());
+			max_index = min_index + range;
+			break;
+		}
+		case rsx::draw_command::inlined_array:
+		{
+			min_index = 0;
+			max_index = ::narrow<u32>(draw_call.inline_vertex_array.size() * sizeof(u32) / m_vertex_layout.interleaved_blocks[0]->attribute_stride) - 1;
+			break;
+		}
+		default:
+		{
+			continue;
+		}
+		}
+
+		const u32 vertex_count = max_index - min_index + 1;
+		const auto [persistent_size, volatile_size] = calculate_memory_requirements(m_vertex_layout, min_index, vertex_count);
+
+		m_vertex_scratch.resize(std::max<usz>(m_vertex_scratch.size(), persistent_size + volatile_size));
+		write_vertex_data_to_memory(m_vertex_layout, min_index, vertex_count,
+			persistent_size ? m_vertex_scratch.data() : nullptr,
+			volatile_size ? m_vertex_scratch.data() + persistent_size : nullptr);
+
+		bench_counters.vertex_upload_bytes += persistent_size + volatile_size;
+		bench_counters.index_upload_bytes += index_bytes;
+	}
+	while (draw_call.next());
+}
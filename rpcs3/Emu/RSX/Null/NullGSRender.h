@@ -10,5 +10,11 @@ public:
 	NullGSRender() noexcept : NullGSRender(nullptr) {}
 
 private:
+	// Host-side scratch used to emulate vertex/index uploads in benchmark mode
+	rsx::vertex_input_layout m_vertex_layout;
+	std::vector<u8> m_vertex_scratch;
+	std::vector<std::byte> m_index_scratch;
+
 	void end() override;
+	void emulate_geometry_upload();
 };
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "overlay_perf_metrics.h"
 #include "Emu/RSX/RSXThread.h"
+#include "Emu/RSX/RSXOffload.h"
 #include "Emu/Cell/SPUThread.h"
 #include "Emu/Cell/PPUThread.h"
 
@@ -474,6 +475,17 @@ namespace rsx
 
 						m_rsx_load = rsx_thread.get_load();
 
+						// DMA offloader throughput and time spent waiting on it, per second
+						const auto& dma = g_fxo->get<rsx::dma_manager>();
+						const u64 dma_bytes = dma.get_enqueued_bytes();
+						const u64 dma_stall_time = dma.get_stall_time();
+						const f32 elapsed_sec = std::max(0.001f, static_cast<f32>(elapsed_update / 1000));
+
+						m_dma_rate = static_cast<f32>(dma_bytes - m_dma_bytes) / (1024 * 1024) / elapsed_sec;
+						m_dma_stall = static_cast<f32>(dma_stall_time - m_dma_stall_time) / 1000 / elapsed_sec;
+						m_dma_bytes = dma_bytes;
+						m_dma_stall_time = dma_stall_time;
+
 						m_total_threads = utils::cpu_stats::get_current_thread_count();
 
 						[[fallthrough]];
@@ -566,8 +578,9 @@ namespace rsx
 					                         " RSX   : %04.1f %% ( 1)\n"
 					                         " Total : %04.1f %% (%2u)\n\n"
 					                         "%s\n"
-					                         " RSX   : %02u %%",
-					    m_fps, m_frametime, std::string(title1_high.size(), ' '), m_ppu_usage, m_ppus, m_spu_usage, m_spus, m_rsx_usage, m_cpu_usage, m_total_threads, std::string(title2.size(), ' '), m_rsx_load);
+					                         " RSX   : %02u %%\n"
+					                         " DMA   : %05.1f MB/s (%04.1f ms/s wait)",
+					    m_fps, m_frametime, std::string(title1_high.size(), ' '), m_ppu_usage, m_ppus, m_spu_usage, m_spus, m_rsx_usage, m_cpu_usage, m_total_threads, std::string(title2.size(), ' '), m_rsx_load, m_dma_rate, m_dma_stall);
 					break;
 				}
 				}
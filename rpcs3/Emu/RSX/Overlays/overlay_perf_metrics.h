@@ -78,6 +78,11 @@ namespace rsx
 			f32 m_rsx_usage{0};
 			u32 m_rsx_load{0};
 
+			u64 m_dma_bytes{0};
+			u64 m_dma_stall_time{0};
+			f32 m_dma_rate{0};
+			f32 m_dma_stall{0};
+
 			void reset_transform(label& elm) const;
 			void reset_transforms();
 			void reset_body();
@@ -726,8 +726,13 @@ namespace rsx
 			performance_counters.idle_time += (rsx::uclock() - performance_counters.FIFO_idle_timestamp);
 		}
 
+		const u64 bench_start = bench_counters.enabled ? utils::get_tsc() : 0;
+		u64 dispatched = 0;
+
 		do
 		{
+			dispatched++;
+
 			if (capture_current_frame) [[unlikely]]
 			{
 				const u32 reg = (command.reg & 0xfffc) >> 2;
@@ -843,5 +848,11 @@ namespace rsx
 		while (fifo_ctrl->read_unsafe(command));
 
 		fifo_ctrl->sync_get();
+
+		if (bench_start) [[unlikely]]
+		{
+			bench_counters.fifo_commands += dispatched;
+			bench_counters.method_ticks += utils::get_tsc() - bench_start;
+		}
 	}
 }
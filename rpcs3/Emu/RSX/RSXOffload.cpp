@@ -6,18 +6,80 @@
 #include "RSXThread.h"
 
 #include <thread>
+#include <chrono>
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 namespace rsx
 {
+	// Raw copies from this size are split between the offloader and its copy workers
+	constexpr u32 split_copy_size = 256 * 1024;
+
+	// Smallest range handed to a single copy worker
+	constexpr u32 split_copy_granularity = 64 * 1024;
+
+	struct dma_manager::copy_worker
+	{
+		struct copy_range
+		{
+			transport_packet job;
+			atomic_t<u32>* pending;
+
+			copy_range(void* dst, void* src, u32 length, atomic_t<u32>* pending)
+				: job(dst, src, length), pending(pending)
+			{}
+		};
+
+		lf_queue<copy_range> m_work_queue;
+
+		void operator()();
+	};
+
 	struct dma_manager::offload_thread
 	{
 		lf_queue<transport_packet> m_work_queue;
 		atomic_t<u64> m_enqueued_count = 0;
 		atomic_t<u64> m_processed_count = 0;
-		transport_packet* m_current_job = nullptr;
 
-		thread_base* current_thread_ = nullptr;
+		const std::shared_ptr<named_thread_group<copy_worker>> m_copy_workers;
+
+		// Set for the offloader and its copy workers
+		static inline thread_local bool s_is_offload_thread = false;
+
+		// Job being processed by the current offload thread, used for fault recovery
+		static inline thread_local transport_packet* s_current_job = nullptr;
+
+		offload_thread(std::shared_ptr<named_thread_group<copy_worker>> copy_workers)
+			: m_copy_workers(std::move(copy_workers))
+		{
+		}
+
+		void split_copy(transport_packet& job)
+		{
+			const u32 worker_count = m_copy_workers->size();
+			const u32 parts = std::min<u32>(worker_count + 1, job.length / split_copy_granularity);
+			const u32 part_size = utils::align(job.length / parts, 4096);
+
+			atomic_t<u32> pending = 0;
+			u32 offset = part_size;
+
+			// Workers take the tail of the range, the offloader copies the head
+			for (u32 i = 0; offset < job.length; i++, offset += part_size)
+			{
+				const u32 length = std::min(part_size, job.length - offset);
+
+				pending++;
+				(m_copy_workers->begin() + i)->m_work_queue.push(static_cast<u8*>(job.dst) + offset, static_cast<u8*>(job.src) + offset, length, &pending);
+			}
+
+			std::memcpy(job.dst, job.src, std::min(part_size, job.length));
+
+			// The ranges are large and short-lived, spin instead of waiting
+			while (pending)
+			{
+				utils::pause();
+			}
+		}
 
 		void operator ()()
 		{
@@ -27,8 +89,7 @@ namespace rsx
 				return;
 			}
 
-			current_thread_ = thread_ctrl::get_current();
-			ensure(current_thread_);
+			s_is_offload_thread = true;
 
 			if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
 			{
@@ -39,14 +100,22 @@ namespace rsx
 			{
 				for (auto&& job : m_work_queue.pop_all())
 				{
-					m_current_job = &job;
+					s_current_job = &job;
 
 					switch (job.type)
 					{
 					case raw_copy:
 					{
 						const u32 vm_addr = vm::try_get_addr(job.src).first;
-						rsx::reservation_lock<true, 1> rsx_lock(vm_addr, job.length, g_cfg.video.strict_rendering_mode && vm_addr);
+						const bool strict = g_cfg.video.strict_rendering_mode && vm_addr;
+
+						if (!strict && m_copy_workers && job.length >= split_copy_size)
+						{
+							split_copy(job);
+							break;
+						}
+
+						rsx::reservation_lock<true, 1> rsx_lock(vm_addr, job.length, strict);
 						std::memcpy(job.dst, job.src, job.length);
 						break;
 					}
@@ -71,7 +140,7 @@ namespace rsx
 					m_processed_count.release(m_processed_count + 1);
 				}
 
-				m_current_job = nullptr;
+				s_current_job = nullptr;
 
 				if (m_enqueued_count.load() == m_processed_count.load())
 				{
@@ -87,10 +156,44 @@ namespace rsx
 		static constexpr auto thread_name = "RSX Offloader"sv;
 	};
 
+	void dma_manager::copy_worker::operator()()
+	{
+		offload_thread::s_is_offload_thread = true;
+
+		if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+		{
+			thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+		}
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			for (auto&& range : m_work_queue.pop_all())
+			{
+				offload_thread::s_current_job = &range.job;
+				std::memcpy(range.job.dst, range.job.src, range.job.length);
+				offload_thread::s_current_job = nullptr;
+
+				// The offloader may return as soon as this reaches zero
+				(*range.pending)--;
+			}
+
+			thread_ctrl::wait_on(m_work_queue, nullptr);
+		}
+	}
+
 	// initialization
 	void dma_manager::init()
 	{
-		m_thread = std::make_shared<named_thread<offload_thread>>();
+		if (g_cfg.video.multithreaded_rsx)
+		{
+			// Leave most of the host to the emulated threads
+			if (const u32 worker_count = std::min<u32>(utils::get_thread_count() / 4, 3))
+			{
+				m_copy_workers = std::make_shared<named_thread_group<copy_worker>>("RSX Offloader Worker ", worker_count);
+			}
+		}
+
+		m_thread = std::make_shared<named_thread<offload_thread>>(m_copy_workers);
 	}
 
 	// General transport
@@ -102,6 +205,7 @@ namespace rsx
 		}
 		else
 		{
+			m_enqueued_bytes += length;
 			m_thread->m_enqueued_count++;
 			m_thread->m_work_queue.push(dst, src, length);
 		}
@@ -117,6 +221,7 @@ namespace rsx
 		}
 		else
 		{
+			m_enqueued_bytes += length;
 			m_thread->m_enqueued_count++;
 			m_thread->m_work_queue.push(dst, src, length);
 		}
@@ -149,12 +254,7 @@ namespace rsx
 	// Synchronization
 	bool dma_manager::is_current_thread() const
 	{
-		if (auto cpu = thread_ctrl::get_current())
-		{
-			return m_thread->current_thread_ == cpu;
-		}
-
-		return false;
+		return offload_thread::s_is_offload_thread;
 	}
 
 	bool dma_manager::sync() const
@@ -167,6 +267,8 @@ namespace rsx
 			return true;
 		}
 
+		const auto wait_start = std::chrono::steady_clock::now();
+
 		if (auto rsxthr = get_current_renderer(); rsxthr->is_current_thread())
 		{
 			if (m_mem_fault_flag)
@@ -187,6 +289,7 @@ namespace rsx
 				utils::pause();
 		}
 
+		m_stall_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count();
 		return true;
 	}
 
@@ -194,11 +297,22 @@ namespace rsx
 	{
 		sync();
 		*m_thread = thread_state::aborting;
+
+		if (m_copy_workers)
+		{
+			for (u32 i = 0; i < m_copy_workers->size(); i++)
+			{
+				(m_copy_workers->begin() + i)->operator=(thread_state::aborting);
+			}
+		}
 	}
 
 	void dma_manager::set_mem_fault_flag()
 	{
 		ensure(is_current_thread()); // "Access denied"
+
+		// Only one offload thread can be recovering at a time
+		m_fault_mutex.lock();
 		m_mem_fault_flag.release(true);
 	}
 
@@ -206,12 +320,13 @@ namespace rsx
 	{
 		ensure(is_current_thread()); // "Access denied"
 		m_mem_fault_flag.release(false);
+		m_fault_mutex.unlock();
 	}
 
 	// Fault recovery
 	utils::address_range dma_manager::get_fault_range(bool writing) const
 	{
-		const auto m_current_job = ensure(m_thread->m_current_job);
+		const auto m_current_job = ensure(offload_thread::s_current_job);
 
 		void *address = nullptr;
 		u32 range = m_current_job->length;
@@ -2,6 +2,7 @@
 
 #include "util/types.hpp"
 #include "Utilities/address_range.h"
+#include "Utilities/mutex.h"
 #include "gcm_enums.h"
 
 #include <vector>
@@ -9,6 +10,9 @@
 template <typename T>
 class named_thread;
 
+template <typename T>
+class named_thread_group;
+
 namespace rsx
 {
 	class dma_manager
@@ -53,12 +57,23 @@ namespace rsx
 
 		atomic_t<bool> m_mem_fault_flag = false;
 
+		// Serializes fault recovery between the offloader and its copy workers
+		shared_mutex m_fault_mutex;
+
 		struct offload_thread;
 		std::shared_ptr<named_thread<offload_thread>> m_thread;
 
+		// Helpers splitting large copies with the offloader, ordering is kept by the offloader
+		struct copy_worker;
+		std::shared_ptr<named_thread_group<copy_worker>> m_copy_workers;
+
 		// TODO: Improved benchmarks here; value determined by profiling on a Ryzen CPU, rounded to the nearest 512 bytes
 		const u32 max_immediate_transfer_size = 3584;
 
+		// Statistics
+		mutable atomic_t<u64> m_enqueued_bytes = 0;
+		mutable atomic_t<u64> m_stall_time = 0;
+
 	public:
 		dma_manager() = default;
 
@@ -84,5 +99,11 @@ namespace rsx
 
 		// Fault recovery
 		utils::address_range get_fault_range(bool writing) const;
+
+		// Total bytes handed to the offloader
+		u64 get_enqueued_bytes() const { return m_enqueued_bytes; }
+
+		// Total time spent waiting for the offloader (in microseconds)
+		u64 get_stall_time() const { return m_stall_time; }
 	};
 }
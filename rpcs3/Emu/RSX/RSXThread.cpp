@@ -21,6 +21,7 @@
 #include "Program/GLSLCommon.h"
 #include "Utilities/date_time.h"
 #include "Utilities/StrUtil.h"
+#include "Emu/trace_events.hpp"
 
 #include "util/serialization.hpp"
 #include "util/asm.hpp"
@@ -752,6 +753,12 @@ namespace rsx
 			return fmt::format("RSX [0x%07x]", rsx->ctrl ? +rsx->ctrl->get : 0);
 		};
 
+		logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+		{
+			const auto rsx = get_current_renderer();
+			prefix.set("RSX [0x%07x]", rsx->ctrl ? +rsx->ctrl->get : 0);
+		});
+
 		if (!serialized) method_registers.init();
 
 		rsx::overlays::reset_performance_overlay();
@@ -3243,6 +3250,18 @@ namespace rsx
 
 	void thread::on_frame_end(u32 buffer, bool forced)
 	{
+		if (g_cfg.core.trace_events) [[unlikely]]
+		{
+			const u64 now = utils::get_tsc();
+
+			if (trace_frame_start)
+			{
+				trace_events::record(trace_category::rsx, "frame", trace_frame_start, now);
+			}
+
+			trace_frame_start = now;
+		}
+
 		// Marks the end of a frame scope GPU-side
 		if (g_user_asked_for_frame_capture.exchange(false) && !capture_current_frame)
 		{
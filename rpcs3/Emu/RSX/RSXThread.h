@@ -584,6 +584,18 @@ namespace rsx
 		}
 		performance_counters;
 
+		// Capture replay benchmark counters (only updated when enabled)
+		struct
+		{
+			bool enabled = false;
+			u64 fifo_commands = 0;       // Commands dispatched to method handlers
+			u64 method_ticks = 0;        // TSC ticks spent dispatching commands
+			u64 vertex_upload_bytes = 0;
+			u64 index_upload_bytes = 0;
+			u64 texture_lookups = 0;
+		}
+		bench_counters;
+
 		enum class flip_request : u32
 		{
 			emu_requested = 1,
@@ -686,6 +698,7 @@ namespace rsx
 		u64 int_flip_index = 0;
 		u64 last_guest_flip_timestamp = 0;
 		u64 last_host_flip_timestamp = 0;
+		u64 trace_frame_start = 0; // TSC at the end of the previous frame (trace events)
 
 		vm::ptr<void(u32)> flip_handler = vm::null;
 		vm::ptr<void(u32)> user_handler = vm::null;
@@ -10,10 +10,13 @@
 #include "Overlays/Shaders/shader_loading_dialog.h"
 
 #include <chrono>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "util/sysinfo.hpp"
 #include "util/fnv_hash.hpp"
+#include "xxhash.h"
 
 namespace rsx
 {
@@ -54,6 +57,31 @@ namespace rsx
 			pipeline_storage_type pipeline_properties;
 		};
 
+		// Packed cache file: header followed by append-only records (record header + payload)
+		struct pack_header
+		{
+			u64 magic;
+			u32 version;
+			u32 pipeline_size; // Binary compatibility check
+		};
+
+		enum pack_record_type : u32
+		{
+			pack_vertex_program = 1,
+			pack_fragment_program = 2,
+			pack_pipeline = 3,
+		};
+
+		struct pack_record
+		{
+			u32 type;
+			u32 size;
+			u64 key; // Program hash or pipeline key
+			u64 checksum; // XXH64 of payload seeded with the key
+		};
+
+		static constexpr u32 c_pack_version = 1;
+
 		std::string version_prefix;
 		std::string root_path;
 		std::string pipeline_class_name;
@@ -61,44 +89,287 @@ namespace rsx
 
 		backend_storage& m_storage;
 
-		static std::string get_message(u32 index, u32 processed, u32 entry_count)
+		// Packed cache state (protected by m_pack_mutex, except blobs which are only read during load)
+		std::mutex m_pack_mutex;
+		bool m_pack_opened = false;
+		fs::file m_pack;
+		fs::file_map m_pack_map;
+		std::unordered_map<u64, std::pair<const u8*, u32>> m_pack_vp;
+		std::unordered_map<u64, std::pair<const u8*, u32>> m_pack_fp;
+		std::unordered_set<u64> m_pack_pipelines;
+		std::vector<pipeline_data> m_pack_entries;
+
+		std::string get_pack_path() const
 		{
-			return fmt::format("%s pipeline object %u of %u", index == 0 ? "Loading" : "Compiling", processed, entry_count);
+			return root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix + ".pack";
 		}
 
-		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::string& directory_path, std::vector<fs::dir_entry>& entries, u32 entry_count,
-		    shader_loading_dialog* dlg)
+		static u64 get_pipeline_key(const pipeline_data& data)
 		{
-			atomic_t<u32> processed(0);
+			u64 state_hash = 0;
+			state_hash ^= rpcs3::hash_base<u32>(data.vp_ctrl);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_ctrl);
+			state_hash ^= rpcs3::hash_base<u32>(data.vp_texture_dimensions);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_texture_dimensions);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_texcoord_control);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_height);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_pixel_layout);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_lighting_flags);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_shadow_textures);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_redirected_textures);
+			state_hash ^= rpcs3::hash_base<u16>(data.vp_multisampled_textures);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_multisampled_textures);
 
-			std::function<void(u32)> shader_load_worker = [&](u32 stop_at)
+			// Same identity as the legacy file name
+			const u64 key[4]{data.vertex_program_hash, data.fragment_program_hash, data.pipeline_storage_hash, state_hash};
+			return XXH64(key, sizeof(key), 0);
+		}
+
+		// Parse existing records, returns offset of the end of valid data
+		u64 parse_pack(const fs::file& f)
+		{
+			m_pack_map = fs::file_map(f);
+
+			const u8* const ptr = m_pack_map.data();
+			const u64 size = m_pack_map.size();
+
+			pack_header header{};
+
+			if (!m_pack_map || size < sizeof(header))
 			{
-				u32 pos;
-				// Processed is incremented before work starts in order to avoid two workers working on the same shader
-				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
-				{
-					fs::dir_entry tmp = entries[pos];
+				return 0;
+			}
 
-					const auto filename = directory_path + "/" + tmp.name;
-					fs::file f(filename);
+			std::memcpy(&header, ptr, sizeof(header));
 
-					if (!f)
+			if (header.magic != "RPCS3SHD"_u64 || header.version != c_pack_version || header.pipeline_size != sizeof(pipeline_data))
+			{
+				rsx_log.error("Removing shader cache %s since it's not binary compatible with the current shader cache", get_pack_path());
+				return 0;
+			}
+
+			u64 pos = sizeof(header);
+
+			while (size - pos >= sizeof(pack_record))
+			{
+				pack_record rec{};
+				std::memcpy(&rec, ptr + pos, sizeof(rec));
+
+				const u8* data = ptr + pos + sizeof(rec);
+
+				if (rec.size > size - pos - sizeof(rec) || XXH64(data, rec.size, rec.key) != rec.checksum)
+				{
+					break;
+				}
+
+				switch (rec.type)
+				{
+				case pack_vertex_program: m_pack_vp.emplace(rec.key, std::make_pair(data, rec.size)); break;
+				case pack_fragment_program: m_pack_fp.emplace(rec.key, std::make_pair(data, rec.size)); break;
+				case pack_pipeline:
+				{
+					if (rec.size == sizeof(pipeline_data) && m_pack_pipelines.emplace(rec.key).second)
 					{
-						// Unexpected error, but avoid crash
-						continue;
+						std::memcpy(&m_pack_entries.emplace_back(), data, sizeof(pipeline_data));
 					}
 
-					if (f.size() != sizeof(pipeline_data))
+					break;
+				}
+				default: break;
+				}
+
+				pos += sizeof(rec) + rec.size;
+			}
+
+			return pos;
+		}
+
+		void reset_pack()
+		{
+			m_pack_map = {};
+			m_pack_vp.clear();
+			m_pack_fp.clear();
+			m_pack_pipelines.clear();
+			m_pack_entries.clear();
+		}
+
+		// Read the packed cache and open it for appending (m_pack_mutex must be locked)
+		bool open_pack()
+		{
+			if (m_pack_opened)
+			{
+				return !!m_pack;
+			}
+
+			m_pack_opened = true;
+
+			const std::string path = get_pack_path();
+
+			if (!fs::create_path(fs::get_parent_dir(path)))
+			{
+				rsx_log.error("Failed to create shader cache directory for %s (%s)", path, fs::g_tls_error);
+				return false;
+			}
+
+			u64 valid_size = 0;
+
+			if (fs::file f{path})
+			{
+				const u64 file_size = f.size();
+				valid_size = parse_pack(f);
+
+				if (valid_size && valid_size != file_size)
+				{
+					// Drop truncated or corrupted tail, the mapping must be released first
+					rsx_log.warning("Shader cache %s: discarding 0x%x invalid bytes at the end", path, file_size - valid_size);
+
+					reset_pack();
+					f.close();
+
+					if (!fs::truncate_file(path, valid_size) || !f.open(path) || parse_pack(f) != valid_size)
 					{
-						rsx_log.error("Removing cached pipeline object %s since it's not binary compatible with the current shader cache", tmp.name.c_str());
-						fs::remove_file(filename);
-						continue;
+						valid_size = 0;
 					}
+				}
+			}
+
+			if (!valid_size)
+			{
+				reset_pack();
+
+				pack_header header{};
+				header.magic = "RPCS3SHD"_u64;
+				header.version = c_pack_version;
+				header.pipeline_size = sizeof(pipeline_data);
+
+				if (!fs::write_file(path, fs::rewrite, &header, sizeof(header)))
+				{
+					rsx_log.error("Failed to create shader cache %s (%s)", path, fs::g_tls_error);
+					return false;
+				}
+			}
+
+			if (!m_pack.open(path, fs::write + fs::append))
+			{
+				rsx_log.error("Failed to open shader cache %s (%s)", path, fs::g_tls_error);
+				return false;
+			}
+
+			return true;
+		}
+
+		// Append record to the packed cache (m_pack_mutex must be locked)
+		void append_record(pack_record_type type, u64 key, const void* data, u32 size)
+		{
+			pack_record rec{};
+			rec.type = type;
+			rec.size = size;
+			rec.key = key;
+			rec.checksum = XXH64(data, size, key);
+
+			// Single write per record
+			std::vector<u8> buf(sizeof(rec) + size);
+			std::memcpy(buf.data(), &rec, sizeof(rec));
+			std::memcpy(buf.data() + sizeof(rec), data, size);
+			m_pack.write(buf);
+		}
+
+		// Append pipeline and its programs unless already stored (m_pack_mutex must be locked)
+		bool append_pipeline(const pipeline_data& data, const void* vp_data, u32 vp_size, const void* fp_data, u32 fp_size)
+		{
+			const u64 key = get_pipeline_key(data);
+
+			if (m_pack_pipelines.contains(key))
+			{
+				return false;
+			}
 
-					pipeline_data pdata{};
-					f.read(&pdata, f.size());
+			if (!m_pack_vp.contains(data.vertex_program_hash))
+			{
+				append_record(pack_vertex_program, data.vertex_program_hash, vp_data, vp_size);
+				m_pack_vp.emplace(data.vertex_program_hash, std::make_pair(nullptr, vp_size));
+			}
+
+			if (!m_pack_fp.contains(data.fragment_program_hash))
+			{
+				append_record(pack_fragment_program, data.fragment_program_hash, fp_data, fp_size);
+				m_pack_fp.emplace(data.fragment_program_hash, std::make_pair(nullptr, fp_size));
+			}
+
+			append_record(pack_pipeline, key, &data, sizeof(data));
+			m_pack_pipelines.emplace(key);
+			return true;
+		}
+
+		// Move pipelines from the old directory layout (one file per pipeline and program) into the packed cache
+		void convert_legacy_cache(const std::string& directory_path)
+		{
+			fs::dir root(directory_path);
+
+			if (!root)
+			{
+				return;
+			}
+
+			u32 converted = 0;
+
+			for (auto&& tmp : root)
+			{
+				if (tmp.is_directory || tmp.size != sizeof(pipeline_data))
+				{
+					continue;
+				}
+
+				pipeline_data data{};
+
+				if (!fs::file(directory_path + "/" + tmp.name).read(data))
+				{
+					continue;
+				}
 
-					auto entry = unpack(pdata);
+				const std::vector<u8> vp = fs::file(fmt::format("%s/raw/%llX.vp", root_path, data.vertex_program_hash)).to_vector<u8>();
+				const std::vector<u8> fp = fs::file(fmt::format("%s/raw/%llX.fp", root_path, data.fragment_program_hash)).to_vector<u8>();
+
+				if (vp.empty() || fp.empty())
+				{
+					continue;
+				}
+
+				if (append_pipeline(data, vp.data(), ::size32(vp), fp.data(), ::size32(fp)))
+				{
+					m_pack_entries.emplace_back(data);
+					converted++;
+				}
+			}
+
+			root.close();
+
+			if (converted)
+			{
+				rsx_log.success("Converted %u cached pipelines of %s to the packed shader cache", converted, directory_path);
+			}
+
+			// Programs in raw/ may still be referenced by other pipeline classes
+			fs::remove_all(directory_path);
+		}
+
+		static std::string get_message(u32 index, u32 processed, u32 entry_count)
+		{
+			return fmt::format("%s pipeline object %u of %u", index == 0 ? "Loading" : "Compiling", processed, entry_count);
+		}
+
+		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::vector<pipeline_data>& entries, u32 entry_count,
+		    shader_loading_dialog* dlg)
+		{
+			atomic_t<u32> processed(0);
+
+			std::function<void(u32)> shader_load_worker = [&](u32 stop_at)
+			{
+				u32 pos;
+				// Processed is incremented before work starts in order to avoid two workers working on the same shader
+				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
+				{
+					auto entry = unpack(entries[pos]);
 
 					if (std::get<1>(entry).data.empty() || !std::get<2>(entry).ucode_length)
 					{
@@ -217,33 +488,33 @@ namespace rsx
 				return;
 			}
 
-			std::string directory_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix;
-
-			fs::dir root = fs::dir(directory_path);
+			const std::string directory_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix;
 
-			if (!root)
+			std::vector<pipeline_data> entries;
 			{
-				fs::create_path(directory_path);
-				fs::create_path(root_path + "/raw");
-				return;
-			}
+				std::lock_guard lock(m_pack_mutex);
 
-			std::vector<fs::dir_entry> entries;
+				if (!open_pack())
+				{
+					return;
+				}
 
-			for (auto&& tmp : root)
-			{
-				if (tmp.is_directory)
-					continue;
+				if (fs::is_dir(directory_path))
+				{
+					convert_legacy_cache(directory_path);
+				}
 
-				entries.push_back(tmp);
+				entries = std::move(m_pack_entries);
+				m_pack_entries.clear();
 			}
 
 			u32 entry_count = ::size32(entries);
 
 			if (!entry_count)
+			{
+				release_pack_map();
 				return;
-
-			root.rewind();
+			}
 
 			// Progress dialog
 			std::unique_ptr<shader_loading_dialog> fallback_dlg;
@@ -263,7 +534,10 @@ namespace rsx
 			unpacked_type unpacked;
 			uint nb_workers = g_cfg.video.renderer == video_renderer::vulkan ? utils::get_thread_count() : 1;
 
-			load_shaders(nb_workers, unpacked, directory_path, entries, entry_count, dlg);
+			load_shaders(nb_workers, unpacked, entries, entry_count, dlg);
+
+			// Programs were copied while unpacking
+			release_pack_map();
 
 			// Account for any invalid entries
 			entry_count = unpacked.size();
@@ -287,46 +561,44 @@ namespace rsx
 				return;
 			}
 
-			pipeline_data data = pack(pipeline, vp, fp);
+			const pipeline_data data = pack(pipeline, vp, fp);
 
-			std::string fp_name = root_path + "/raw/" + fmt::format("%llX.fp", data.fragment_program_hash);
-			std::string vp_name = root_path + "/raw/" + fmt::format("%llX.vp", data.vertex_program_hash);
+			std::lock_guard lock(m_pack_mutex);
 
-			// Writeback to cache either if file does not exist or it is invalid (unexpected size)
-			// Note: fs::write_file is not atomic, if the process is terminated in the middle an empty file is created
-			if (fs::stat_t s{}; !fs::stat(fp_name, s) || s.size != fp.ucode_length)
+			if (open_pack())
 			{
-				fs::write_file(fp_name, fs::rewrite, fp.get_data(), fp.ucode_length);
+				append_pipeline(data, vp.data.data(), ::size32(vp.data) * sizeof(u32), fp.get_data(), fp.ucode_length);
 			}
+		}
+
+		// Drop the mapping of the packed cache, blob pointers are invalidated
+		void release_pack_map()
+		{
+			std::lock_guard lock(m_pack_mutex);
 
-			if (fs::stat_t s{}; !fs::stat(vp_name, s) || s.size != vp.data.size() * sizeof(u32))
+			for (auto* programs : {&m_pack_vp, &m_pack_fp})
 			{
-				fs::write_file(vp_name, fs::rewrite, vp.data);
+				for (auto& [hash, blob] : *programs)
+				{
+					blob.first = nullptr;
+				}
 			}
 
-			u64 state_hash = 0;
-			state_hash ^= rpcs3::hash_base<u32>(data.vp_ctrl);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_ctrl);
-			state_hash ^= rpcs3::hash_base<u32>(data.vp_texture_dimensions);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_texture_dimensions);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_texcoord_control);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_height);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_pixel_layout);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_lighting_flags);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_shadow_textures);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_redirected_textures);
-			state_hash ^= rpcs3::hash_base<u16>(data.vp_multisampled_textures);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_multisampled_textures);
-
-			const std::string pipeline_file_name = fmt::format("%llX+%llX+%llX+%llX.bin", data.vertex_program_hash, data.fragment_program_hash, data.pipeline_storage_hash, state_hash);
-			const std::string pipeline_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix + "/" + pipeline_file_name;
-			fs::write_file(pipeline_path, fs::rewrite, &data, sizeof(data));
+			m_pack_map = {};
 		}
 
 		RSXVertexProgram load_vp_raw(u64 program_hash) const
 		{
 			RSXVertexProgram vp = {};
 
+			if (auto found = m_pack_vp.find(program_hash); found != m_pack_vp.end() && found->second.first)
+			{
+				const auto [ptr, size] = found->second;
+				vp.data.resize(size / sizeof(u32));
+				std::memcpy(vp.data.data(), ptr, vp.data.size() * sizeof(u32));
+				return vp;
+			}
+
 			fs::file f(fmt::format("%s/raw/%llX.vp", root_path, program_hash));
 			if (f) f.read(vp.data, f.size() / sizeof(u32));
 
@@ -335,10 +607,22 @@ namespace rsx
 
 		RSXFragmentProgram load_fp_raw(u64 program_hash)
 		{
-			fs::file f(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
-
 			RSXFragmentProgram fp = {};
 
+			if (auto found = m_pack_fp.find(program_hash); found != m_pack_fp.end() && found->second.first)
+			{
+				const auto [ptr, size] = found->second;
+				fp.ucode_length = size;
+
+				auto buf = std::make_unique<u8[]>(size);
+				fp.data = buf.get();
+				std::memcpy(buf.get(), ptr, size);
+				fragment_program_data[fragment_program_data.push_begin()] = std::move(buf);
+				return fp;
+			}
+
+			fs::file f(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
+
 			const u32 size = fp.ucode_length = f ? ::size32(f) : 0;
 
 			if (!size)
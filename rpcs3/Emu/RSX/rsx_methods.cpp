@@ -461,11 +461,50 @@ namespace rsx
 			rsx::method_registers.current_draw_clause.append(v.start(), v.count());
 		}
 
-		void draw_inline_array(thread* /*rsx*/, u32 /*reg*/, u32 arg)
+		void draw_inline_array(thread* rsx, u32 /*reg*/, u32 arg)
 		{
-			arg = std::bit_cast<u32, be_t<u32>>(arg);
-			rsx::method_registers.current_draw_clause.command = rsx::draw_command::inlined_array;
-			rsx::method_registers.current_draw_clause.inline_vertex_array.push_back(arg);
+			auto& draw_call = rsx::method_registers.current_draw_clause;
+			draw_call.command = rsx::draw_command::inlined_array;
+
+			if ((rsx->fifo_ctrl->last_cmd() & RSX_METHOD_NON_INCREMENT_CMD_MASK) != RSX_METHOD_NON_INCREMENT_CMD)
+			{
+				draw_call.inline_vertex_array.push_back(std::bit_cast<u32, be_t<u32>>(arg));
+				return;
+			}
+
+			// Non-incrementing packet, the whole vertex stream targets this method so it can be appended at once
+
+			// FIFO args count including this one
+			const u32 fifo_args_cnt = rsx->fifo_ctrl->get_remaining_args_count() + 1;
+
+			// Get limit imposed by FIFO PUT (if put is behind get it will result in a number ignored by min)
+			const u32 fifo_read_limit = static_cast<u32>(((rsx->ctrl->put & ~3ull) - (rsx->fifo_ctrl->get_pos())) / 4);
+
+			const auto fifo_span = rsx->fifo_ctrl->get_current_arg_ptr();
+
+			const u32 count = std::min<u32>({fifo_args_cnt, fifo_read_limit, ::size32(fifo_span)});
+
+			if (count <= 1)
+			{
+				draw_call.inline_vertex_array.push_back(std::bit_cast<u32, be_t<u32>>(arg));
+				return;
+			}
+
+			auto& data = draw_call.inline_vertex_array;
+			const u32 old_size = data.size();
+
+			// Grow geometrically, large streams are split over many packets
+			if (old_size + count > data.capacity())
+			{
+				data.reserve(std::max(old_size + count, data.capacity() * 2));
+			}
+
+			data.resize(old_size + count);
+
+			// Stored in guest byte order, the vertex program performs the swap
+			std::memcpy(data.data() + old_size, fifo_span.data(), count * sizeof(u32));
+
+			rsx->fifo_ctrl->skip_methods(count - 1);
 		}
 
 		struct set_transform_constant
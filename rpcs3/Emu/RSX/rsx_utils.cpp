@@ -24,7 +24,10 @@ extern "C"
 #pragma GCC diagnostic pop
 #endif
 
+#include "Utilities/Thread.h"
+#include "Emu/IdManager.h"
 #include "util/sysinfo.hpp"
+#include "util/asm.hpp"
 
 namespace rsx
 {
@@ -39,6 +42,120 @@ namespace rsx
 		sws_scale(sws.get(), &src, &src_pitch, 0, src_slice_h, &dst, &dst_pitch);
 	}
 
+	// Persistent helper threads for run_parallel_rows (created on first use)
+	struct parallel_rows_pool
+	{
+		struct worker
+		{
+			parallel_rows_pool* pool;
+
+			void operator()()
+			{
+				while (thread_ctrl::state() != thread_state::aborting)
+				{
+					const u64 job = pool->m_state.load();
+					pool->work(static_cast<u32>(job >> 32));
+					thread_ctrl::wait_on(pool->m_state, job);
+				}
+			}
+		};
+
+		// Serializes callers, a busy pool falls back to the calling thread
+		shared_mutex m_mutex;
+
+		// Current job: id (high 32 bits), chunk count (16 bits), next chunk (low 16 bits)
+		atomic_t<u64> m_state = 0;
+		atomic_t<u32> m_pending = 0;
+
+		// Job parameters, only read after claiming a chunk of the current job
+		const std::function<void(u32, u32)>* m_func = nullptr;
+		u32 m_count = 0;
+		u32 m_chunk = 0;
+
+		std::unique_ptr<named_thread_group<worker>> m_workers;
+
+		// Process chunks of the given job until there are none left
+		void work(u32 id)
+		{
+			while (true)
+			{
+				const auto [old, ok] = m_state.fetch_op([&](u64& v)
+				{
+					if (static_cast<u32>(v >> 32) != id || (v & 0xffff) >= ((v >> 16) & 0xffff))
+					{
+						return false;
+					}
+
+					v++;
+					return true;
+				});
+
+				if (!ok)
+				{
+					return;
+				}
+
+				const u32 index = old & 0xffff;
+				(*m_func)(index * m_chunk, std::min(m_count, (index + 1) * m_chunk));
+
+				if (m_pending.sub_fetch(1) == 0)
+				{
+					m_pending.notify_all();
+				}
+			}
+		}
+	};
+
+	void run_parallel_rows(u32 count, u32 granularity, usz bytes, const std::function<void(u32, u32)>& func)
+	{
+		// Small images are not worth waking up helper threads
+		const u32 max_threads = std::min<u32>(4, utils::get_thread_count() / 2);
+
+		if (bytes < 4 * 1024 * 1024 || max_threads < 2 || count < granularity * 2)
+		{
+			func(0, count);
+			return;
+		}
+
+		auto& pool = g_fxo->get<parallel_rows_pool>();
+
+		std::unique_lock lock(pool.m_mutex, std::try_to_lock);
+
+		if (!lock)
+		{
+			func(0, count);
+			return;
+		}
+
+		if (!pool.m_workers)
+		{
+			pool.m_workers = std::make_unique<named_thread_group<parallel_rows_pool::worker>>("RSX Swizzle ", max_threads - 1, parallel_rows_pool::worker{&pool});
+		}
+
+		// Split into equal aligned chunks, the last one takes the remainder
+		const u32 chunk = utils::align(std::max<u32>(count / max_threads, 1), std::max<u32>(granularity, 1));
+		const u32 chunks = (count + chunk - 1) / chunk;
+
+		pool.m_func = &func;
+		pool.m_count = count;
+		pool.m_chunk = chunk;
+		pool.m_pending = chunks;
+
+		const u32 id = static_cast<u32>(pool.m_state.load() >> 32) + 1;
+		pool.m_state = u64{id} << 32 | u64{chunks} << 16;
+		pool.m_state.notify_all();
+
+		// Help with the job and wait for the remaining chunks
+		pool.work(id);
+
+		while (const u32 pending = pool.m_pending.load())
+		{
+			pool.m_pending.wait(pending);
+		}
+
+		pool.m_func = nullptr;
+	}
+
 	void clip_image(u8 *dst, const u8 *src, int clip_x, int clip_y, int clip_w, int clip_h, int bpp, int src_pitch, int dst_pitch)
 	{
 		const u8* pixels_src = src + clip_y * src_pitch + clip_x * bpp;
@@ -8,6 +8,7 @@
 #include <memory>
 #include <bitset>
 #include <chrono>
+#include <functional>
 
 extern "C"
 {
@@ -347,6 +348,25 @@ namespace rsx
 		return offset;
 	}
 
+	// Scatter low bits of the value to the set bits of the mask (portable PDEP)
+	static inline u32 deposit_bits(u32 value, u32 mask)
+	{
+		u32 result = 0;
+
+		for (u32 m = mask; m && value; m &= m - 1, value >>= 1)
+		{
+			if (value & 1)
+			{
+				result |= m & (0 - m);
+			}
+		}
+
+		return result;
+	}
+
+	// Run func(begin, end) over [0, count) ranges aligned to granularity, split across worker threads if bytes is large enough
+	void run_parallel_rows(u32 count, u32 granularity, usz bytes, const std::function<void(u32, u32)>& func);
+
 	/*   Note: What the ps3 calls swizzling in this case is actually z-ordering / morton ordering of pixels
 	*       - Input can be swizzled or linear, bool flag handles conversion to and from
 	*       - It will handle any width and height that are a power of 2, square or non square
@@ -356,63 +376,90 @@ namespace rsx
 	template <typename T, bool input_is_swizzled>
 	void convert_linear_swizzle(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch)
 	{
-		u32 log2width = ceil_log2(width);
-		u32 log2height = ceil_log2(height);
-
-		// Max mask possible for square texture
-		u32 x_mask = 0x55555555;
-		u32 y_mask = 0xAAAAAAAA;
+		const u32 log2width = ceil_log2(width);
+		const u32 log2height = ceil_log2(height);
 
 		// We have to limit the masks to the lower of the two dimensions to allow for non-square textures
-		u32 limit_mask = (log2width < log2height) ? log2width : log2height;
-		// double the limit mask to account for bits in both x and y
-		limit_mask = 1 << (limit_mask << 1);
+		const u32 log2limit = std::min(log2width, log2height);
 
-		//x_mask, bits above limit are 1's for x-carry
-		x_mask = (x_mask | ~(limit_mask - 1));
-		//y_mask. bits above limit are 0'd, as we use a different method for y-carry over
-		y_mask = (y_mask & (limit_mask - 1));
+		// Double the limit to account for bits in both x and y
+		const u32 limit_mask = 1 << (log2limit << 1);
 
-		u32 offs_y = 0;
-		u32 offs_x = 0;
-		u32 offs_x0 = 0; //total y-carry offset for x
-		u32 y_incr = limit_mask;
+		// x_mask, bits above limit are 1's for x-carry
+		const u32 x_mask = 0x55555555 | ~(limit_mask - 1);
 
-		u32 adv = pitch / sizeof(T);
+		// y_mask, bits above limit are 0'd, as we use a different method for y-carry over
+		const u32 y_mask = 0xAAAAAAAA & (limit_mask - 1);
 
-		if constexpr (!input_is_swizzled)
+		const u32 adv = pitch / sizeof(T);
+
+		// Both x and y have an interleaved bit: every 2x2 block is 4 contiguous texels in swizzled order
+		const bool use_blocks = log2limit > 0 && width % 2 == 0 && height % 2 == 0;
+
+		const auto convert_rows = [&](u32 y_begin, u32 y_end)
 		{
-			for (int y = 0; y < height; ++y)
-			{
-				auto src = static_cast<const T*>(input_pixels) + y * adv;
-				auto dst = static_cast<T*>(output_pixels) + offs_y;
-				offs_x = offs_x0;
+			// Offsets of the first row (y-carry over adds limit_mask every 2^log2limit rows)
+			u32 offs_y = deposit_bits(y_begin, y_mask);
+			u32 offs_x0 = (y_begin >> log2limit) * limit_mask;
 
-				for (int x = 0; x < width; ++x)
-				{
-					dst[offs_x] = src[x];
-					offs_x = (offs_x - x_mask) & x_mask;
-				}
+			auto linear = static_cast<std::conditional_t<input_is_swizzled, T*, const T*>>(input_is_swizzled ? output_pixels : const_cast<void*>(input_pixels)) + y_begin * adv;
+			auto swizzled = static_cast<std::conditional_t<input_is_swizzled, const T*, T*>>(input_is_swizzled ? const_cast<void*>(input_pixels) : output_pixels);
 
-				offs_y = (offs_y - y_mask) & y_mask;
+			if (use_blocks)
+			{
+				// Masks without the lowest bits, to advance by 2 texels/rows
+				const u32 x_mask2 = x_mask & ~1u;
+				const u32 y_mask2 = y_mask & ~2u;
 
-				if (offs_y == 0)
+				for (u32 y = y_begin; y < y_end; y += 2, linear += adv * 2)
 				{
-					offs_x0 += y_incr;
+					const auto block_row = swizzled + offs_y;
+					u32 offs_x = offs_x0;
+
+					for (u32 x = 0; x < width; x += 2)
+					{
+						// Texels (x, y), (x + 1, y), (x, y + 1), (x + 1, y + 1)
+						if constexpr (input_is_swizzled)
+						{
+							std::memcpy(linear + x, block_row + offs_x, sizeof(T) * 2);
+							std::memcpy(linear + adv + x, block_row + offs_x + 2, sizeof(T) * 2);
+						}
+						else
+						{
+							std::memcpy(block_row + offs_x, linear + x, sizeof(T) * 2);
+							std::memcpy(block_row + offs_x + 2, linear + adv + x, sizeof(T) * 2);
+						}
+
+						offs_x = (offs_x - x_mask2) & x_mask2;
+					}
+
+					offs_y = (offs_y - y_mask2) & y_mask2;
+
+					if (offs_y == 0)
+					{
+						offs_x0 += limit_mask;
+					}
 				}
+
+				return;
 			}
-		}
-		else
-		{
-			for (int y = 0; y < height; ++y)
+
+			for (u32 y = y_begin; y < y_end; y++, linear += adv)
 			{
-				auto src = static_cast<const T*>(input_pixels) + offs_y;
-				auto dst = static_cast<T*>(output_pixels) + y * adv;
-				offs_x = offs_x0;
+				const auto row = swizzled + offs_y;
+				u32 offs_x = offs_x0;
 
-				for (int x = 0; x < width; ++x)
+				for (u32 x = 0; x < width; x++)
 				{
-					dst[x] = src[offs_x];
+					if constexpr (input_is_swizzled)
+					{
+						linear[x] = row[offs_x];
+					}
+					else
+					{
+						row[offs_x] = linear[x];
+					}
+
 					offs_x = (offs_x - x_mask) & x_mask;
 				}
 
@@ -420,10 +467,12 @@ namespace rsx
 
 				if (offs_y == 0)
 				{
-					offs_x0 += y_incr;
+					offs_x0 += limit_mask;
 				}
 			}
-		}
+		};
+
+		run_parallel_rows(height, use_blocks ? 2 : 1, usz{width} * height * sizeof(T), convert_rows);
 	}
 
 	/**
@@ -448,13 +497,23 @@ namespace rsx
 		const u32 log2_h = ceil_log2(height);
 		const u32 log2_d = ceil_log2(depth);
 
-		for (u32 z = 0; z < depth; ++z)
+		// Bits of the swizzled offset owned by each coordinate (computed once instead of per texel)
+		u32 x_mask = 0, y_mask = 0, z_mask = 0;
+
+		for (u32 i = 0; i < log2_w; i++) x_mask |= calculate_z_index(1u << i, 0, 0, log2_w, log2_h, log2_d);
+		for (u32 i = 0; i < log2_h; i++) y_mask |= calculate_z_index(0, 1u << i, 0, log2_w, log2_h, log2_d);
+		for (u32 i = 0; i < log2_d; i++) z_mask |= calculate_z_index(0, 0, 1u << i, log2_w, log2_h, log2_d);
+
+		// Increment coordinates directly in their bit fields
+		for (u32 z = 0, offs_z = 0; z < depth; ++z, offs_z = (offs_z - z_mask) & z_mask)
 		{
-			for (u32 y = 0; y < height; ++y)
+			for (u32 y = 0, offs_y = 0; y < height; ++y, offs_y = (offs_y - y_mask) & y_mask)
 			{
-				for (u32 x = 0; x < width; ++x)
+				const u32 offs_zy = offs_z | offs_y;
+
+				for (u32 x = 0, offs_x = 0; x < width; ++x, offs_x = (offs_x - x_mask) & x_mask)
 				{
-					*dst++ = src[calculate_z_index(x, y, z, log2_w, log2_h, log2_d)];
+					*dst++ = src[offs_zy | offs_x];
 				}
 			}
 		}
@@ -7,6 +7,7 @@
 #include "Emu/system_utils.hpp"
 #include "Emu/perf_meter.hpp"
 #include "Emu/perf_monitor.hpp"
+#include "Emu/trace_events.hpp"
 #include "Emu/vfs_config.h"
 #include "Emu/IPC_config.h"
 
@@ -43,6 +44,7 @@
 #include <memory>
 #include <regex>
 #include <optional>
+#include <random>
 
 #include "Utilities/JIT.h"
 
@@ -81,6 +83,11 @@ extern std::pair<std::shared_ptr<lv2_overlay>, CellError> ppu_load_overlay(const
 extern bool ppu_load_rel_exec(const ppu_rel_object&);
 extern bool is_savestate_version_compatible(const std::vector<std::pair<u16, u16>>& data, bool is_boot_check);
 extern std::vector<std::pair<u16, u16>> read_used_savestate_versions();
+extern std::vector<std::pair<u16, u16>> get_savestate_versioning_data(const fs::file& file);
+extern bool is_savestate_compressed(const fs::file& file);
+extern std::unique_ptr<utils::serialization_file_handler> make_compressed_savestate_writer(const std::string& path);
+extern std::unique_ptr<utils::serialization_file_handler> make_compressed_savestate_reader(fs::file&& file);
+extern bool archive_savestate_base(u64 id);
 
 fs::file g_tty;
 atomic_t<s64> g_tty_size{0};
@@ -553,7 +560,7 @@ std::string Emulator::GetBackgroundPicturePath() const
 	return path;
 }
 
-bool Emulator::BootRsxCapture(const std::string& path)
+bool Emulator::BootRsxCapture(const std::string& path, u32 bench_iterations)
 {
 	fs::file in_file(path);
 
@@ -596,6 +603,14 @@ bool Emulator::BootRsxCapture(const std::string& path)
 	Init();
 	g_cfg.video.disable_on_disk_shader_cache.set(true);
 
+	if (bench_iterations)
+	{
+		// Measure the CPU side of RSX only, as fast as possible
+		g_cfg.video.renderer.set(video_renderer::null);
+		g_cfg.video.frame_limit.set(frame_limit_type::infinite);
+		sys_log.notice("Benchmarking rsx capture %s (%u iterations)", path, bench_iterations);
+	}
+
 	vm::init();
 	g_fxo->init(false);
 
@@ -615,7 +630,7 @@ bool Emulator::BootRsxCapture(const std::string& path)
 	GetCallbacks().on_run(false);
 	m_state = system_state::starting;
 
-	ensure(g_fxo->init<named_thread<rsx::rsx_replay_thread>>("RSX Replay", std::move(frame)));
+	ensure(g_fxo->init<named_thread<rsx::rsx_replay_thread>>("RSX Replay", std::move(frame), bench_iterations));
 
 	return true;
 }
@@ -665,9 +680,18 @@ game_boot_result Emulator::BootGame(const std::string& path, const std::string&
 	{
 		m_ar = std::make_shared<utils::serial>();
 		m_ar->set_reading_state();
-		save.seek(0);
-		save.read(m_ar->data, save.size());
-		m_ar->data.shrink_to_fit();
+
+		if (is_savestate_compressed(save))
+		{
+			// Decompress the savestate while loading it
+			m_ar->m_file_handler = make_compressed_savestate_reader(std::move(save));
+		}
+		else
+		{
+			save.seek(0);
+			save.read(m_ar->data, save.size());
+			m_ar->data.shrink_to_fit();
+		}
 	}
 
 	if (direct || m_ar || fs::is_file(path))
@@ -738,6 +762,16 @@ void Emulator::SetForceBoot(bool force_boot)
 	m_force_boot = force_boot;
 }
 
+game_boot_result Emulator::BootJitBenchmark(const std::string& path, u32 thread_count)
+{
+	m_jit_bench = true;
+	m_jit_bench_threads = thread_count;
+	m_jit_bench_elf = fs::is_file(path) ? path : "";
+
+	// Use directory scan mode
+	return BootGame(m_jit_bench_elf.empty() ? path : fs::get_parent_dir(path), "", true);
+}
+
 game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool is_disc_patch)
 {
 	if (m_config_mode == cfg_mode::continuous)
@@ -835,22 +869,32 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 				return game_boot_result::savestate_corrupted;
 			}
 	
-			if (header.LE_format != (std::endian::native == std::endian::little) || header.offset >= m_ar->data.size())
+			if (header.LE_format != (std::endian::native == std::endian::little) || (!m_ar->m_file_handler && header.offset >= m_ar->data.size()))
 			{
 				return game_boot_result::savestate_corrupted;
 			}
 
 			g_cfg.savestate.state_inspection_mode.set(header.state_inspection_support);
-	
-			// Emulate seek operation (please avoid using in other places)
-			m_ar->pos = header.offset;
 
-			if (!is_savestate_version_compatible(m_ar->operator std::vector<std::pair<u16, u16>>(), true))
+			std::vector<std::pair<u16, u16>> versions;
+
+			if (m_ar->m_file_handler)
 			{
-				return game_boot_result::savestate_version_unsupported;
+				// Compressed savestate: the versioning data is stored uncompressed at the end of the file
+				versions = get_savestate_versioning_data(fs::file(m_path));
+			}
+			else
+			{
+				// Emulate seek operation (please avoid using in other places)
+				m_ar->pos = header.offset;
+				versions = *m_ar;
+				m_ar->pos = sizeof(file_header); // Restore position
 			}
 
-			m_ar->pos = sizeof(file_header); // Restore position
+			if (!is_savestate_version_compatible(versions, true))
+			{
+				return game_boot_result::savestate_version_unsupported;
+			}
 
 			argv.clear();
 			klic.clear();
@@ -887,7 +931,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 				if (size)
 				{
 					fs::remove_all(path, false);
-					ensure(tar_object(fs::file(&m_ar->data[m_ar->pos], size)).extract(path));
+					ensure(tar_object(fs::file(ensure(m_ar->peek(size)), size)).extract(path));
 					m_ar->pos += size;
 				}
 			};
@@ -1181,6 +1225,11 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 			// Force LLVM recompiler
 			g_cfg.core.ppu_decoder.from_default();
 
+			if (m_jit_bench)
+			{
+				g_cfg.core.llvm_threads.set(m_jit_bench_threads);
+			}
+
 			// Force LLE lib loading mode
 			g_cfg.core.libraries_control.set_set([]()
 			{
@@ -1241,6 +1290,13 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 					dir_queue.insert(std::end(dir_queue), std::begin(dirs), std::end(dirs));
 				}
 
+				if (m_jit_bench && !m_jit_bench_elf.empty())
+				{
+					// Only compile the given executable
+					path = m_jit_bench_elf;
+					dir_queue.clear();
+				}
+
 				if (fs::is_file(path))
 				{
 					// Compile binary first
@@ -1282,6 +1338,13 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 
 			g_fxo->init<named_thread>("SPRX Loader"sv, [this, dir_queue]() mutable
 			{
+				jit_compile_stats bench_stats;
+
+				if (m_jit_bench)
+				{
+					jit_compile_stats::set_total(&bench_stats);
+				}
+
 				if (auto& _main = g_fxo->get<ppu_module>(); !_main.path.empty())
 				{
 					ppu_initialize(_main);
@@ -1289,11 +1352,27 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 
 				ppu_precompile(dir_queue, nullptr);
 
+				if (m_jit_bench)
+				{
+					jit_compile_stats::set_total(nullptr);
+
+					// Cached modules are loaded without compilation and are not counted
+					const std::string report = fmt::format("PPU LLVM compilation benchmark: %s\n  %s", m_path, bench_stats.summary(rpcs3::utils::get_max_threads()));
+					sys_log.success("%s", report);
+					std::fprintf(stdout, "%s\n", report.c_str());
+					std::fflush(stdout);
+				}
+
 				// Exit "process"
 				CallFromMainThread([this]
 				{
 					Emu.Kill(false);
 					m_path = m_path_old; // Reset m_path to fix boot from gui
+
+					if (m_jit_bench)
+					{
+						Emu.Quit(true);
+					}
 				});
 			});
 
@@ -1640,6 +1719,11 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 			{
 				return fmt::format("Emu State Load Thread: '%s'", g_tls_serialize_name);
 			};
+
+			logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+			{
+				prefix.set("Emu State Load Thread: '%s'", g_tls_serialize_name);
+			});
 		}
 
 		fs::file elf_file(elf_path);
@@ -1979,6 +2063,8 @@ void Emulator::FixGuestTime()
 			{
 				return std::string();
 			};
+
+			logs::set_tls_raw_prefix([](logs::raw_prefix& prefix) { prefix.set(""); });
 		});
 	}
 	else
@@ -2256,6 +2342,8 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 		return std::string();
 	};
 
+	logs::set_tls_raw_prefix([](logs::raw_prefix& prefix) { prefix.set(""); });
+
 	if (m_state.exchange(system_state::stopped) == system_state::stopped)
 	{
 		// Ensure clean state
@@ -2353,10 +2441,28 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 
 	sys_log.notice("All threads have been stopped.");
 
+	const std::string savestate_path = savestate ? fs::get_cache_dir() + "/savestates/" + (m_title_id.empty() ? m_path.substr(m_path.find_last_of(fs::delim) + 1) : m_title_id) + ".SAVESTAT" : std::string();
+
+	// Unique savestate ID, delta savestates refer to their base savestate by it
+	const u64 savestate_id = savestate ? (u64{std::random_device{}()} << 32 | std::random_device{}()) | 1 : 0;
+	u64 parent_id = savestate && g_cfg.savestate.delta_savestates ? vm::get_delta_base_id() : 0;
+
+	if (parent_id && !archive_savestate_base(parent_id))
+	{
+		sys_log.error("Failed to keep the base savestate, saving a full savestate instead.");
+		parent_id = 0;
+	}
+
 	if (savestate)
 	{
 		to_ar = std::make_unique<utils::serial>();
 
+		if (g_cfg.savestate.compression)
+		{
+			// Stream the savestate to the file while it is being captured
+			to_ar->m_file_handler = make_compressed_savestate_writer(savestate_path);
+		}
+
 		// Savestate thread
 		named_thread emu_state_cap_thread("Emu State Capture Thread", [&]()
 		{
@@ -2365,6 +2471,11 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 				return fmt::format("Emu State Capture Thread: '%s'", g_tls_serialize_name);
 			};
 
+			logs::set_tls_raw_prefix([](logs::raw_prefix& prefix)
+			{
+				prefix.set("Emu State Capture Thread: '%s'", g_tls_serialize_name);
+			});
+
 			auto& ar = *to_ar;
 
 			read_used_savestate_versions(); // Reset version data
@@ -2380,6 +2491,7 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 				const usz tar_size = ar.data.size() - old_size;
 				std::memcpy(ar.data.data() + old_size - sizeof(usz), &tar_size, sizeof(usz));
 				sys_log.success("Saved the contents of directory '%s' (size=0x%x)", path, tar_size);
+				ar.breathe();
 			};
 
 			auto save_hdd1 = [&]()
@@ -2429,8 +2541,10 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 			ar("RPCS3SAV"_u64);
 			ar(std::endian::native == std::endian::little);
 			ar(g_cfg.savestate.state_inspection_mode.get());
-			ar(std::array<u8, 32>{}); // Reserved for future use
 			ar(usz{0}); // Offset of versioning data, to be overwritten at the end of saving
+			ar(u8{0}, u64{0}); // Compression and stream size (set by the compressed savestate writer)
+			ar(savestate_id, parent_id);
+			ar(std::array<u8, 7>{}); // Reserved for future use
 
 			if (auto dir = vfs::get("/dev_bdvd/PS3_GAME"); fs::is_dir(dir) && !fs::is_file(fs::get_parent_dir(dir) + "/PS3_DISC.SFB"))
 			{
@@ -2451,7 +2565,8 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 			save_hdd1();
 			save_hdd0();
 			ar(std::array<u8, 32>{}); // Reserved for future use
-			vm::save(ar);
+			vm::save(ar, savestate_id, parent_id != 0);
+			ar.breathe();
 			g_fxo->save(ar);
 			ar(std::array<u8, 32>{}); // Reserved for future use
 			ar(timestamp);
@@ -2484,6 +2599,11 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 
 	perf_stat_base::report();
 
+	if (g_cfg.core.trace_events)
+	{
+		trace_events::dump();
+	}
+
 	static u64 aw_refs = 0;
 	static u64 aw_colm = 0;
 	static u64 aw_colc = 0;
@@ -2512,19 +2632,34 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 
 	if (savestate)
 	{
-		const std::string path = fs::get_cache_dir() + "/savestates/" + (m_title_id.empty() ? m_path.substr(m_path.find_last_of(fs::delim) + 1) : m_title_id) + ".SAVESTAT";
-
-		fs::pending_file file(path);
+		const std::string& path = savestate_path;
 
 		// Identifer -> version
 		std::vector<std::pair<u16, u16>> used_serial = read_used_savestate_versions();
 
 		auto& ar = *to_ar;
-		const usz pos = ar.seek_end();
-		std::memcpy(&ar.data[10], &pos, 8);// Set offset
-		ar(used_serial);
 
-		if (!file.file || (file.file.write(ar.data), !file.commit()))
+		bool saved = false;
+
+		if (ar.m_file_handler)
+		{
+			// Compress the rest of the state, the versioning data is stored uncompressed after it
+			ar.breathe(true);
+			ar(used_serial);
+			saved = ar.m_file_handler->finalize(ar);
+		}
+		else
+		{
+			fs::pending_file file(path);
+
+			const usz pos = ar.seek_end();
+			std::memcpy(&ar.data[10], &pos, 8);// Set offset
+			ar(used_serial);
+
+			saved = file.file && (file.file.write(ar.data), file.commit());
+		}
+
+		if (!saved)
 		{
 			sys_log.error("Failed to write savestate to file! (path='%s', %s)", path, fs::g_tls_error);
 		}
@@ -2556,7 +2691,15 @@ std::shared_ptr<utils::serial> Emulator::Kill(bool allow_autoexit, bool savestat
 			}
 		}
 
-		ar.set_reading_state();
+		if (ar.m_file_handler)
+		{
+			// The data is no longer in memory
+			to_ar.reset();
+		}
+		else
+		{
+			ar.set_reading_state();
+		}
 	}
 
 	// Boot arg cleanup (preserved in the case restarting)
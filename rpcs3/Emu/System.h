@@ -144,6 +144,11 @@ class Emulator final
 
 	bool m_state_inspection_savestate = false;
 
+	// JIT compilation benchmark (directory scan mode, quits when done)
+	bool m_jit_bench = false;
+	u32 m_jit_bench_threads = 0;
+	std::string m_jit_bench_elf;
+
 	std::vector<std::function<void()>> deferred_deserialization;
 
 	void ExecDeserializationRemnants()
@@ -291,10 +296,13 @@ public:
 	}
 
 	game_boot_result BootGame(const std::string& path, const std::string& title_id = "", bool direct = false, bool add_only = false, cfg_mode config_mode = cfg_mode::custom, const std::string& config_path = "");
-	bool BootRsxCapture(const std::string& path);
+	bool BootRsxCapture(const std::string& path, u32 bench_iterations = 0);
 
 	void SetForceBoot(bool force_boot);
 
+	// Precompile PPU modules of a directory or a single executable, report compilation statistics and quit
+	game_boot_result BootJitBenchmark(const std::string& path, u32 thread_count);
+
 	game_boot_result Load(const std::string& title_id = "", bool add_only = false, bool is_disc_patch = false);
 	void Run(bool start_playtime);
 	void RunPPU();
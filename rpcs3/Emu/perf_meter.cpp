@@ -134,6 +134,37 @@ void perf_stat_base::remove(u64 ns[66], const char* name) noexcept
 	}
 }
 
+std::vector<std::pair<std::string, std::array<u64, 66>>> perf_stat_base::snapshot()
+{
+	std::map<std::string_view, std::array<u64, 66>> stats;
+
+	// Only registration paths take this lock, push() remains lock-free
+	std::lock_guard lock(s_perf_mutex);
+
+	for (auto& [name, acc] : s_perf_acc)
+	{
+		auto& data = stats[name];
+
+		for (u32 i = 0; i < 66; i++)
+		{
+			data[i] += acc.m_log[i].load();
+		}
+	}
+
+	// Add values not yet accumulated from the threads (may be slightly inconsistent)
+	for (auto& [name, ns] : s_perf_sources)
+	{
+		auto& data = stats[name];
+
+		for (u32 i = 0; i < 66; i++)
+		{
+			data[i] += atomic_storage<u64>::load(ns[i]);
+		}
+	}
+
+	return {stats.begin(), stats.end()};
+}
+
 void perf_stat_base::report() noexcept
 {
 	std::lock_guard lock(s_perf_mutex);
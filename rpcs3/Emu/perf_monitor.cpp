@@ -1,15 +1,85 @@
 #include "stdafx.h"
 #include "perf_monitor.hpp"
+#include "perf_meter.hpp"
+#include "system_config.h"
+#include "Emu/RSX/RSXThread.h"
 #include "util/cpu_stats.hpp"
+#include "util/sysinfo.hpp"
+#include "Utilities/File.h"
 #include "Utilities/Thread.h"
 
 LOG_CHANNEL(sys_log, "SYS");
 
+extern atomic_t<u32> g_lv2_preempts_taken;
+
+// Write snapshot of performance counters in Prometheus text format
+static void export_telemetry(double total_usage, const std::vector<double>& per_core_usage, double fps)
+{
+	std::string out;
+	out.reserve(64 * 1024);
+
+	out += "# HELP rpcs3_cpu_usage_percent Host CPU usage.\n";
+	out += "# TYPE rpcs3_cpu_usage_percent gauge\n";
+	fmt::append(out, "rpcs3_cpu_usage_percent{core=\"total\"} %.2f\n", total_usage);
+
+	for (usz i = 0; i < per_core_usage.size(); i++)
+	{
+		fmt::append(out, "rpcs3_cpu_usage_percent{core=\"%u\"} %.2f\n", i, per_core_usage[i]);
+	}
+
+	out += "# HELP rpcs3_threads Number of threads in the process.\n";
+	out += "# TYPE rpcs3_threads gauge\n";
+	fmt::append(out, "rpcs3_threads %u\n", utils::cpu_stats::get_current_thread_count());
+
+	out += "# HELP rpcs3_fps Frames flipped per second.\n";
+	out += "# TYPE rpcs3_fps gauge\n";
+	fmt::append(out, "rpcs3_fps %.2f\n", fps);
+
+	out += "# HELP rpcs3_lv2_preempts_taken CPU preemptions taken since the last yield frequency change.\n";
+	out += "# TYPE rpcs3_lv2_preempts_taken gauge\n";
+	fmt::append(out, "rpcs3_lv2_preempts_taken %u\n", g_lv2_preempts_taken.load());
+
+	out += "# HELP rpcs3_perf_event_seconds Duration of perf_meter events (requires Enable Performance Report).\n";
+	out += "# TYPE rpcs3_perf_event_seconds histogram\n";
+
+	for (const auto& [name, data] : perf_stat_base::snapshot())
+	{
+		// Bucket i counts events of [2^(i-1), 2^i) ns, zero-length events are only counted in data[0]
+		u64 count = data[0];
+
+		for (u32 i = 1; i < 65; i++)
+		{
+			count -= std::min(count, data[i]);
+		}
+
+		// Buckets up to 2^40 ns (~18 min)
+		for (u32 i = 1; i <= 40; i++)
+		{
+			count += data[i];
+			fmt::append(out, "rpcs3_perf_event_seconds_bucket{event=\"%s\",le=\"%g\"} %u\n", name, std::ldexp(1e-9, i), count);
+		}
+
+		fmt::append(out, "rpcs3_perf_event_seconds_bucket{event=\"%s\",le=\"+Inf\"} %u\n", name, data[0]);
+		fmt::append(out, "rpcs3_perf_event_seconds_sum{event=\"%s\"} %.9f\n", name, data[65] / 1000'000'000.);
+		fmt::append(out, "rpcs3_perf_event_seconds_count{event=\"%s\"} %u\n", name, data[0]);
+	}
+
+	// Replace the file atomically so readers never see partial data
+	fs::pending_file file(fs::get_cache_dir() + "perf_telemetry.prom");
+
+	if (!file.file || !file.file.write(out) || !file.commit())
+	{
+		sys_log.error("Failed to write performance telemetry (%s)", fs::g_tls_error);
+	}
+}
+
 void perf_monitor::operator()()
 {
 	constexpr u64 update_interval_us = 1000000; // Update every second
 	constexpr u64 log_interval_us = 10000000;   // Log every 10 seconds
 	u64 elapsed_us = 0;
+	u64 telemetry_elapsed_us = 0;
+	u64 last_flip_index = 0;
 
 	utils::cpu_stats stats;
 	stats.init_cpu_query();
@@ -18,6 +88,7 @@ void perf_monitor::operator()()
 	{
 		thread_ctrl::wait_for(update_interval_us);
 		elapsed_us += update_interval_us;
+		telemetry_elapsed_us += update_interval_us;
 
 		double total_usage = 0.0;
 		std::vector<double> per_core_usage;
@@ -42,6 +113,23 @@ void perf_monitor::operator()()
 
 			sys_log.notice("%s", msg);
 		}
+
+		if (const u64 interval = g_cfg.core.perf_telemetry_interval; interval && telemetry_elapsed_us >= interval * 1000000)
+		{
+			u64 flip_index = last_flip_index;
+
+			if (const auto rsx = rsx::get_current_renderer())
+			{
+				flip_index = atomic_storage<u64>::load(rsx->int_flip_index);
+			}
+
+			const double fps = flip_index >= last_flip_index ? (flip_index - last_flip_index) * 1000000. / telemetry_elapsed_us : 0.;
+
+			last_flip_index = flip_index;
+			telemetry_elapsed_us = 0;
+
+			export_telemetry(total_usage, per_core_usage, fps);
+		}
 	}
 }
 
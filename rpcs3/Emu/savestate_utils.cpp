@@ -6,8 +6,16 @@
 #include "system_config.h"
 
 #include "System.h"
+#include "system_utils.hpp"
+
+#include "Utilities/Thread.h"
 
 #include <set>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <zlib.h>
 
 LOG_CHANNEL(sys_log, "SYS");
 
@@ -35,7 +43,7 @@ static std::array<serial_ver_t, 23> s_serial_versions;
 		return ::s_serial_versions[identifier].current_version;\
 	}
 
-SERIALIZATION_VER(global_version, 0,                            12) // For stuff not listed here
+SERIALIZATION_VER(global_version, 0,                            12, 13/*savestate IDs, delta savestates*/) // For stuff not listed here
 SERIALIZATION_VER(ppu, 1,                                       1)
 SERIALIZATION_VER(spu, 2,                                       1, 2 /*spu_limits_t ctor*/)
 SERIALIZATION_VER(lv2_sync, 3,                                  1)
@@ -218,3 +226,507 @@ bool boot_last_savestate()
 
 	return false;
 }
+
+// Layout of the header of savestate files
+struct savestate_header
+{
+	ENABLE_BITWISE_SERIALIZATION;
+
+	nse_t<u64, 1> magic;
+	bool LE_format;
+	bool state_inspection_support;
+	nse_t<u64, 1> offset; // Offset of versioning data (file offset of the uncompressed tail in compressed savestates)
+	u8 compression;
+	nse_t<u64, 1> stream_size; // Size of the serialized stream preceding the tail (compressed savestates)
+	nse_t<u64, 1> id; // Unique ID of the savestate
+	nse_t<u64, 1> parent_id; // ID of the base savestate of delta savestates
+	std::array<u8, 7> reserved;
+};
+
+static_assert(sizeof(savestate_header) == 50);
+
+// Chunk of compressed data (followed by its data)
+struct compressed_savestate_chunk
+{
+	ENABLE_BITWISE_SERIALIZATION;
+
+	nse_t<u32, 1> compressed_size;
+	nse_t<u32, 1> size;
+};
+
+// Compression method stored in the header
+constexpr u8 c_savestate_zlib_chunks = 1;
+
+// Uncompressed size of each chunk
+constexpr usz c_savestate_chunk_size = 0x400000;
+
+bool is_savestate_compressed(const fs::file& file)
+{
+	savestate_header header{};
+
+	if (!file || file.size() < sizeof(header))
+	{
+		return false;
+	}
+
+	file.seek(0);
+	const bool ok = file.read(header) && header.magic == "RPCS3SAV"_u64 && header.compression == c_savestate_zlib_chunks;
+	file.seek(0);
+	return ok;
+}
+
+// Compresses the stream in chunks on worker threads and writes them in order to the file
+class compressed_savestate_writer final : public utils::serialization_file_handler
+{
+	struct chunk_job
+	{
+		u64 index;
+		std::vector<u8> data;
+	};
+
+	fs::pending_file m_file;
+	const std::string m_path;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::deque<chunk_job> m_jobs; // Uncompressed chunks
+	std::map<u64, std::vector<u8>> m_done; // Compressed chunks waiting for their turn to be written
+	u64 m_next_index = 0;
+	u64 m_pending = 0; // Chunks which have not been written yet
+	bool m_finished = false;
+
+	std::mutex m_write_mutex;
+	u64 m_next_write = 0;
+	atomic_t<bool> m_failed = false;
+
+	bool m_header_written = false;
+
+	const u32 m_max_pending;
+
+	struct worker
+	{
+		compressed_savestate_writer* _this;
+
+		void operator()() const;
+	};
+
+	std::unique_ptr<named_thread_group<worker>> m_workers;
+
+	void write_file(const void* ptr, usz size)
+	{
+		if (m_file.file.write(ptr, size) != size)
+		{
+			m_failed = true;
+		}
+	}
+
+	void write_chunks()
+	{
+		// Write finished chunks in order
+		std::lock_guard lock_write(m_write_mutex);
+
+		while (true)
+		{
+			std::vector<u8> ready;
+			{
+				std::lock_guard lock(m_mutex);
+
+				const auto found = m_done.find(m_next_write);
+
+				if (found == m_done.end())
+				{
+					break;
+				}
+
+				ready = std::move(found->second);
+				m_done.erase(found);
+			}
+
+			write_file(ready.data(), ready.size());
+			m_next_write++;
+
+			std::lock_guard lock(m_mutex);
+			m_pending--;
+			m_cv.notify_all();
+		}
+	}
+
+	void push(const u8* ptr, usz size)
+	{
+		std::unique_lock lock(m_mutex);
+
+		// Limit the amount of memory used by chunks in flight
+		m_cv.wait(lock, [&]() { return m_pending < m_max_pending; });
+
+		m_jobs.push_back(chunk_job{m_next_index++, std::vector<u8>(ptr, ptr + size)});
+		m_pending++;
+		m_cv.notify_all();
+	}
+
+public:
+	compressed_savestate_writer(const std::string& path)
+		: m_file(path)
+		, m_path(path)
+		, m_max_pending(std::max<u32>(rpcs3::utils::get_max_threads(), 2) * 2)
+	{
+		m_workers = std::make_unique<named_thread_group<worker>>("Savestate Compression ", std::clamp<u32>(rpcs3::utils::get_max_threads(), 1, 8), worker{this});
+	}
+
+	~compressed_savestate_writer()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_finished = true;
+			m_cv.notify_all();
+		}
+
+		m_workers.reset();
+	}
+
+	explicit operator bool() const
+	{
+		return !!m_file.file;
+	}
+
+	bool handle_file_op(utils::serial& ar, usz pos, usz size) override
+	{
+		ensure(ar.is_writing() && !size && pos == ar.data_offset + ar.data.size());
+
+		const u8* ptr = ar.data.data();
+		usz left = ar.data.size();
+
+		if (!m_header_written)
+		{
+			// The header is stored uncompressed
+			savestate_header header{};
+			ensure(left >= sizeof(header));
+			std::memcpy(&header, ptr, sizeof(header));
+			header.compression = c_savestate_zlib_chunks;
+			header.stream_size = 0;
+
+			std::lock_guard lock(m_write_mutex);
+			write_file(&header, sizeof(header));
+
+			ptr += sizeof(header);
+			left -= sizeof(header);
+			m_header_written = true;
+		}
+
+		for (; left; )
+		{
+			const usz chunk_size = std::min<usz>(left, c_savestate_chunk_size);
+			push(ptr, chunk_size);
+			ptr += chunk_size;
+			left -= chunk_size;
+		}
+
+		ar.data_offset += ar.data.size();
+		ar.data.clear();
+		return !m_failed;
+	}
+
+	bool finalize(utils::serial& ar) override
+	{
+		ensure(m_header_written);
+
+		// Wait for all chunks to be written
+		{
+			std::unique_lock lock(m_mutex);
+			m_cv.wait(lock, [&]() { return m_pending == 0; });
+		}
+
+		std::lock_guard lock(m_write_mutex);
+
+		// Write the tail uncompressed and patch the header
+		const u64 tail_offset = m_file.file.size();
+		write_file(ar.data.data(), ar.data.size());
+
+		m_file.file.seek(offsetof(savestate_header, offset));
+		write_file(&tail_offset, sizeof(tail_offset));
+
+		const u64 stream_size = ar.data_offset;
+		m_file.file.seek(offsetof(savestate_header, stream_size));
+		write_file(&stream_size, sizeof(stream_size));
+
+		if (m_failed || !m_file.commit())
+		{
+			sys_log.error("Failed to write compressed savestate! (path='%s', %s)", m_path, fs::g_tls_error);
+			return false;
+		}
+
+		sys_log.notice("Compressed savestate: size=0x%x, compressed=0x%x (%.1f%%)", ar.data_offset + ar.data.size(), tail_offset + ar.data.size(), (tail_offset + ar.data.size()) * 100. / std::max<usz>(ar.data_offset + ar.data.size(), 1));
+		return true;
+	}
+};
+
+void compressed_savestate_writer::worker::operator()() const
+{
+	while (true)
+	{
+		chunk_job job;
+		{
+			std::unique_lock lock(_this->m_mutex);
+			_this->m_cv.wait(lock, [&]() { return _this->m_finished || !_this->m_jobs.empty(); });
+
+			if (_this->m_jobs.empty())
+			{
+				break;
+			}
+
+			job = std::move(_this->m_jobs.front());
+			_this->m_jobs.pop_front();
+		}
+
+		std::vector<u8> out(sizeof(compressed_savestate_chunk) + compressBound(static_cast<uLong>(job.data.size())));
+
+		uLongf out_size = static_cast<uLongf>(out.size() - sizeof(compressed_savestate_chunk));
+
+		if (compress2(out.data() + sizeof(compressed_savestate_chunk), &out_size, job.data.data(), static_cast<uLong>(job.data.size()), Z_BEST_SPEED) != Z_OK)
+		{
+			_this->m_failed = true;
+		}
+
+		compressed_savestate_chunk chunk{};
+		chunk.compressed_size = static_cast<u32>(out_size);
+		chunk.size = static_cast<u32>(job.data.size());
+		std::memcpy(out.data(), &chunk, sizeof(chunk));
+		out.resize(sizeof(chunk) + out_size);
+
+		{
+			std::lock_guard lock(_this->m_mutex);
+			_this->m_done.emplace(job.index, std::move(out));
+		}
+
+		_this->write_chunks();
+	}
+}
+
+// Reads and decompresses the stream sequentially
+class compressed_savestate_reader final : public utils::serialization_file_handler
+{
+	fs::file m_file;
+	savestate_header m_header{};
+	usz m_stream_pos = 0; // Stream position at the end of the buffer
+	std::vector<u8> m_buf;
+
+	bool fetch_chunk(utils::serial& ar)
+	{
+		if (m_stream_pos == 0)
+		{
+			// The header is stored uncompressed
+			ar.data.insert(ar.data.end(), reinterpret_cast<const u8*>(&m_header), reinterpret_cast<const u8*>(&m_header) + sizeof(m_header));
+			m_stream_pos = sizeof(m_header);
+			m_file.seek(sizeof(m_header));
+			return true;
+		}
+
+		if (m_stream_pos >= m_header.stream_size || m_file.pos() >= m_header.offset)
+		{
+			return false;
+		}
+
+		compressed_savestate_chunk chunk{};
+
+		if (!m_file.read(chunk))
+		{
+			return false;
+		}
+
+		m_buf.resize(chunk.compressed_size);
+
+		if (m_file.read(m_buf.data(), m_buf.size()) != m_buf.size())
+		{
+			return false;
+		}
+
+		const usz old_size = ar.data.size();
+		ar.data.resize(old_size + chunk.size);
+
+		uLongf dst_size = chunk.size;
+
+		if (uncompress(ar.data.data() + old_size, &dst_size, m_buf.data(), static_cast<uLong>(m_buf.size())) != Z_OK || dst_size != chunk.size)
+		{
+			sys_log.error("Failed to decompress savestate chunk at 0x%x", m_stream_pos);
+			ar.data.resize(old_size);
+			return false;
+		}
+
+		m_stream_pos += chunk.size;
+		return true;
+	}
+
+public:
+	compressed_savestate_reader(fs::file&& file)
+		: m_file(std::move(file))
+	{
+		m_file.seek(0);
+		ensure(m_file.read(m_header));
+	}
+
+	bool handle_file_op(utils::serial& ar, usz pos, usz size) override
+	{
+		ensure(!ar.is_writing());
+
+		while (true)
+		{
+			// Discard consumed data
+			if (pos > ar.data_offset)
+			{
+				const usz consumed = std::min<usz>(pos - ar.data_offset, ar.data.size());
+				ar.data.erase(ar.data.begin(), ar.data.begin() + consumed);
+				ar.data_offset += consumed;
+			}
+
+			if (pos + size <= m_stream_pos)
+			{
+				return true;
+			}
+
+			if (!fetch_chunk(ar))
+			{
+				return false;
+			}
+		}
+	}
+
+	bool finalize(utils::serial&) override
+	{
+		return true;
+	}
+};
+
+std::unique_ptr<utils::serialization_file_handler> make_compressed_savestate_writer(const std::string& path)
+{
+	auto handler = std::make_unique<compressed_savestate_writer>(path);
+
+	if (!*handler)
+	{
+		sys_log.error("Failed to create savestate file (path='%s', %s)", path, fs::g_tls_error);
+		return nullptr;
+	}
+
+	return handler;
+}
+
+std::unique_ptr<utils::serialization_file_handler> make_compressed_savestate_reader(fs::file&& file)
+{
+	return std::make_unique<compressed_savestate_reader>(std::move(file));
+}
+
+u64 get_savestate_id(const fs::file& file)
+{
+	savestate_header header{};
+
+	if (!file || file.size() < sizeof(header))
+	{
+		return 0;
+	}
+
+	file.seek(0);
+	const bool ok = file.read(header) && header.magic == "RPCS3SAV"_u64;
+	file.seek(0);
+	return ok ? u64{header.id} : 0;
+}
+
+// Find savestate file by its ID, base savestates of delta savestates are looked up first
+static std::string find_savestate_by_id(u64 id)
+{
+	const std::string save_dir = fs::get_cache_dir() + "/savestates/";
+
+	for (const std::string& dir : {save_dir + "base/", save_dir})
+	{
+		for (auto&& entry : fs::dir(dir))
+		{
+			if (entry.is_directory)
+			{
+				continue;
+			}
+
+			if (std::string path = dir + entry.name; get_savestate_id(fs::file(path)) == id)
+			{
+				return path;
+			}
+		}
+	}
+
+	return {};
+}
+
+// Move the base of a delta savestate out of the way of savestate rotation
+bool archive_savestate_base(u64 id)
+{
+	const std::string base_dir = fs::get_cache_dir() + "/savestates/base/";
+	const std::string path = find_savestate_by_id(id);
+
+	if (path.empty())
+	{
+		sys_log.error("Failed to find the base savestate of delta savestate (id=0x%x)", id);
+		return false;
+	}
+
+	if (path.starts_with(base_dir))
+	{
+		return true;
+	}
+
+	const std::string new_path = fmt::format("%s%016x.SAVESTAT", base_dir, id);
+
+	if (!fs::create_path(base_dir) || !fs::rename(path, new_path, true))
+	{
+		sys_log.error("Failed to move base savestate '%s' to '%s' (%s)", path, new_path, fs::g_tls_error);
+		return false;
+	}
+
+	sys_log.notice("Base savestate has been moved to path='%s'", new_path);
+	return true;
+}
+
+// Open savestate by ID and skip to its memory section (see Emulator::Load)
+std::shared_ptr<utils::serial> open_savestate_memory_section(u64 id)
+{
+	const std::string path = find_savestate_by_id(id);
+
+	if (path.empty())
+	{
+		return nullptr;
+	}
+
+	fs::file file(path);
+
+	auto ar = std::make_shared<utils::serial>();
+	ar->set_reading_state();
+
+	if (is_savestate_compressed(file))
+	{
+		ar->m_file_handler = make_compressed_savestate_reader(std::move(file));
+	}
+	else
+	{
+		file.read(ar->data, file.size());
+	}
+
+	ar->pos = sizeof(savestate_header);
+
+	std::string argv0, disc_info, game_dir, hdd1;
+	std::array<u8, 16> klic{};
+	(*ar)(argv0, disc_info, klic, game_dir, hdd1);
+
+	auto skip_tar = [&]()
+	{
+		const usz size = *ar;
+		ar->pos += size;
+	};
+
+	if (!hdd1.empty())
+	{
+		skip_tar();
+	}
+
+	while (!ar->operator std::string().empty())
+	{
+		skip_tar();
+	}
+
+	ar->pos += 32; // Reserved area
+	return ar;
+}
@@ -28,6 +28,7 @@ struct cfg_root : cfg::node
 		cfg::_int<0, 1024> llvm_threads{ this, "Max LLVM Compile Threads", 0 };
 		cfg::_bool ppu_llvm_greedy_mode{ this, "PPU LLVM Greedy Mode", false, false };
 		cfg::_bool ppu_llvm_precompilation{ this, "PPU LLVM Precompilation", true };
+		cfg::_bool ppu_llvm_lazy_linking{ this, "PPU LLVM Lazy Linking", false }; // Link object parts on the first call of their functions
 		cfg::_enum<thread_scheduler_mode> thread_scheduler{this, "Thread Scheduler Mode", thread_scheduler_mode::os};
 		cfg::_bool set_daz_and_ftz{ this, "Set DAZ and FTZ", false };
 		cfg::_enum<spu_decoder_type> spu_decoder{ this, "SPU Decoder", spu_decoder_type::llvm };
@@ -101,6 +102,8 @@ struct cfg_root : cfg::node
 
 		cfg::uint64 perf_report_threshold{this, "Performance Report Threshold", 500, true}; // In µs, 0.5ms = default, 0 = everything
 		cfg::_bool perf_report{this, "Enable Performance Report", false, true}; // Show certain perf-related logs
+		cfg::_bool trace_events{this, "Enable Trace Events", false, true}; // Record syscall/HLE/SPU/RSX timeline for Chrome trace-event export
+		cfg::uint<0, 3600> perf_telemetry_interval{this, "Performance Telemetry Interval", 0, true}; // In seconds, 0 = disabled, writes perf_telemetry.prom next to RPCS3.log
 		cfg::_bool external_debugger{this, "Assume External Debugger"};
 	} core{ this };
 
@@ -317,6 +320,8 @@ struct cfg_root : cfg::node
 		cfg::_bool suspend_emu{ this, "Suspend Emulation Savestate Mode", true }; // Close emulation when saving, delete save after loading
 		cfg::_bool state_inspection_mode{ this, "Inspection Mode Savestates" }; // Save memory stored in executable files, thus allowing to view state without any files (for debugging)
 		cfg::_bool save_disc_game_data{ this, "Save Disc Game Data", false };
+		cfg::_bool compression{ this, "Compress Savestates", true }; // Stream savestates to the file compressed instead of building them in memory
+		cfg::_bool delta_savestates{ this, "Delta Savestates", false }; // Only save memory which changed since the savestate the emulation was loaded from
 	} savestate{this};
 
 	struct node_misc : cfg::node
@@ -10,6 +10,9 @@
 #include "Crypto/unpkg.h"
 #include "Crypto/unself.h"
 #include "Crypto/unedat.h"
+#include "Loader/PUP.h"
+#include "Loader/TAR.h"
+#include "Emu/VFS.h"
 
 #include <charconv>
 #include <thread>
@@ -111,6 +114,192 @@ namespace rpcs3::utils
 		return worker();
 	}
 
+	firmware_install_result install_firmware_packages(tar_object& update_files, const std::vector<std::string>& packages, atomic_t<u32>& progress)
+	{
+		const u32 count = ::size32(packages);
+		const u32 thread_count = std::clamp<u32>(get_max_threads(), 1, std::clamp<u32>(count, 1, 8));
+
+		// Each dev_flash package is independent, only reading the PUP TAR is serialized
+		std::mutex tar_mutex;
+		atomic_t<u32> next_package = 0;
+		atomic_t<firmware_install_result> result = firmware_install_result::success;
+
+		// Per stage statistics (time is summed over all threads)
+		atomic_t<u64> read_us = 0, decrypt_us = 0, extract_us = 0;
+		atomic_t<u64> package_bytes = 0, tar_bytes = 0;
+
+		const auto start = steady_clock::now();
+
+		named_thread_group workers("Firmware Installer ", thread_count, [&]()
+		{
+			for (u32 index; (index = next_package++) < count && progress < count;)
+			{
+				const std::string& update_filename = packages[index];
+
+				auto stage_start = steady_clock::now();
+
+				const auto stage_end = [&](atomic_t<u64>& stage_us)
+				{
+					const auto now = steady_clock::now();
+					stage_us += std::chrono::duration_cast<std::chrono::microseconds>(now - stage_start).count();
+					stage_start = now;
+				};
+
+				fs::file update_file;
+				{
+					std::lock_guard lock(tar_mutex);
+					update_file = update_files.get_file(update_filename);
+				}
+
+				package_bytes += update_file.size();
+				stage_end(read_us);
+
+				SCEDecrypter self_dec(update_file);
+				self_dec.LoadHeaders();
+				self_dec.LoadMetadata(SCEPKG_ERK, SCEPKG_RIV);
+				self_dec.DecryptData();
+
+				auto dev_flash_tar_f = self_dec.MakeFile();
+				stage_end(decrypt_us);
+
+				if (dev_flash_tar_f.size() < 3)
+				{
+					sys_log.error("Error while installing firmware: PUP contents are invalid. (package=%s)", update_filename);
+					result.compare_and_swap(firmware_install_result::success, firmware_install_result::invalid_package);
+					progress = -1;
+					return;
+				}
+
+				tar_bytes += dev_flash_tar_f[2].size();
+
+				tar_object dev_flash_tar(dev_flash_tar_f[2]);
+
+				if (!dev_flash_tar.extract())
+				{
+					sys_log.error("Error while installing firmware: TAR contents are invalid. (package=%s)", update_filename);
+					result.compare_and_swap(firmware_install_result::success, firmware_install_result::extract_failed);
+					progress = -1;
+					return;
+				}
+
+				stage_end(extract_us);
+
+				if (!progress.try_inc(count))
+				{
+					// Installation was cancelled
+					return;
+				}
+			}
+		});
+
+		workers.join();
+
+		if (result != firmware_install_result::success)
+		{
+			return result;
+		}
+
+		if (progress != count)
+		{
+			return firmware_install_result::cancelled;
+		}
+
+		const auto mb_per_s = [](u64 bytes, u64 us)
+		{
+			return us ? bytes / 1.048576 / us : 0.;
+		};
+
+		const double elapsed = std::chrono::duration<double>(steady_clock::now() - start).count();
+
+		sys_log.notice("Installed %u firmware packages in %.3fs with %u threads (%.1f MB/s)", count, elapsed, thread_count, package_bytes / 1048576. / std::max(elapsed, 0.001));
+		sys_log.notice("Firmware install stages (per thread): read %.1f MB/s, decrypt %.1f MB/s, extract %.1f MB/s",
+			mb_per_s(package_bytes, read_us), mb_per_s(package_bytes, decrypt_us), mb_per_s(tar_bytes, extract_us));
+
+		return firmware_install_result::success;
+	}
+
+	bool install_pup(const std::string& path)
+	{
+		sys_log.success("Installing firmware: %s", path);
+
+		fs::file pup_f(path);
+
+		if (!pup_f)
+		{
+			sys_log.error("Error opening PUP file %s (%s)", path, fs::g_tls_error);
+			return false;
+		}
+
+		pup_object pup(std::move(pup_f));
+
+		if (const pup_error error = pup.operator pup_error(); error != pup_error::ok)
+		{
+			sys_log.error("Error while installing firmware: PUP file is invalid (error=%u)\n%s", static_cast<u32>(error), pup.get_formatted_error());
+			return false;
+		}
+
+		fs::file update_files_f = pup.get_file(0x300);
+
+		if (!update_files_f)
+		{
+			sys_log.error("Error while installing firmware: Couldn't find installation packages database.");
+			return false;
+		}
+
+		tar_object update_files(update_files_f);
+
+		auto update_filenames = update_files.get_filenames();
+
+		std::erase_if(update_filenames, [](const std::string& s) { return s.find("dev_flash_") == umax; });
+
+		if (update_filenames.empty())
+		{
+			sys_log.error("Error while installing firmware: No dev_flash_* packages were found.");
+			return false;
+		}
+
+		std::string version_string;
+
+		if (fs::file version = pup.get_file(0x100))
+		{
+			version_string = version.to_string();
+		}
+
+		if (const usz version_pos = version_string.find('\n'); version_pos != umax)
+		{
+			version_string.erase(version_pos);
+		}
+
+		if (version_string.empty())
+		{
+			sys_log.error("Error while installing firmware: No version data was found.");
+			return false;
+		}
+
+		if (static constexpr std::string_view cur_version = "4.89"; version_string < cur_version)
+		{
+			sys_log.warning("Old firmware detected: the newest firmware version is %s, installing version %s", cur_version, version_string);
+		}
+
+		if (std::string installed = ::utils::get_firmware_version(); !installed.empty())
+		{
+			sys_log.warning("Reinstalling firmware: old=%s, new=%s", installed, version_string);
+		}
+
+		// Used by tar_object::extract() as destination directory
+		vfs::mount("/dev_flash", g_cfg_vfs.get_dev_flash());
+
+		atomic_t<u32> progress = 0;
+
+		if (install_firmware_packages(update_files, update_filenames, progress) != firmware_install_result::success)
+		{
+			return false;
+		}
+
+		sys_log.success("Successfully installed PS3 firmware version %s.", version_string);
+		return true;
+	}
+
 #ifdef _WIN32
 	std::string get_exe_dir()
 	{
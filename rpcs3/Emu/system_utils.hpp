@@ -1,10 +1,22 @@
 #pragma once
 
 #include "util/types.hpp"
+#include "util/atomic.hpp"
 #include <string>
+#include <vector>
+
+class tar_object;
 
 namespace rpcs3::utils
 {
+	enum class firmware_install_result
+	{
+		success,
+		cancelled,
+		invalid_package, // Decryption or decompression failed
+		extract_failed,
+	};
+
 	u32 get_max_threads();
 
 	void configure_logs();
@@ -13,6 +25,13 @@ namespace rpcs3::utils
 
 	bool install_pkg(const std::string& path);
 
+	// Install dev_flash_* packages of the PUP update TAR using multiple threads (/dev_flash must be mounted)
+	// Progress counts installed packages, set it to -1 to cancel
+	firmware_install_result install_firmware_packages(tar_object& update_files, const std::vector<std::string>& packages, atomic_t<u32>& progress);
+
+	// Install PUP file without user interaction
+	bool install_pup(const std::string& path);
+
 #ifdef _WIN32
 	std::string get_exe_dir();
 #elif defined(__APPLE__)
@@ -0,0 +1,185 @@
+#include "stdafx.h"
+#include "trace_events.hpp"
+
+#include "util/sysinfo.hpp"
+#include "Utilities/Thread.h"
+#include "Utilities/File.h"
+#include "Utilities/date_time.h"
+#include "Utilities/mutex.h"
+
+#include <memory>
+
+LOG_CHANNEL(perf_log, "PERF");
+
+template <>
+void fmt_class_string<trace_category>::format(std::string& out, u64 arg)
+{
+	format_enum(out, arg, [](trace_category value)
+	{
+		switch (value)
+		{
+		case trace_category::syscall: return "syscall";
+		case trace_category::hle: return "hle";
+		case trace_category::spu: return "spu";
+		case trace_category::rsx: return "rsx";
+		}
+
+		return unknown;
+	});
+}
+
+namespace
+{
+	struct trace_event
+	{
+		u64 start;
+		u64 end;
+		const char* name;
+		u32 name_size;
+		trace_category cat;
+	};
+
+	// Single producer ring buffer, old events are overwritten
+	struct trace_buffer
+	{
+		static constexpr u64 capacity = 1 << 16;
+
+		std::unique_ptr<trace_event[]> events = std::make_unique<trace_event[]>(capacity);
+
+		// Number of events written (only advanced by the owner thread)
+		atomic_t<u64> pos = 0;
+
+		std::string thread_name;
+	};
+}
+
+static shared_mutex s_trace_mutex;
+
+// All buffers ever registered (kept after thread exit until dumped)
+static std::vector<std::shared_ptr<trace_buffer>> s_trace_buffers;
+
+static thread_local std::shared_ptr<trace_buffer> g_tls_trace_buffer;
+
+void trace_events::record(trace_category cat, std::string_view name, u64 start, u64 end) noexcept
+{
+	auto& buf = g_tls_trace_buffer;
+
+	if (!buf) [[unlikely]]
+	{
+		buf = std::make_shared<trace_buffer>();
+		buf->thread_name = thread_ctrl::get_current() ? thread_ctrl::get_name() : "Unknown";
+
+		std::lock_guard lock(s_trace_mutex);
+		s_trace_buffers.emplace_back(buf);
+	}
+
+	const u64 pos = buf->pos.observe();
+	buf->events[pos % trace_buffer::capacity] = {start, end, name.data(), static_cast<u32>(name.size()), cat};
+	buf->pos.release(pos + 1);
+}
+
+static void append_json_string(std::string& out, std::string_view str)
+{
+	out += '"';
+
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out += '\\';
+		}
+		else if (static_cast<u8>(c) < 0x20)
+		{
+			fmt::append(out, "\\u%04x", static_cast<u8>(c));
+			continue;
+		}
+
+		out += c;
+	}
+
+	out += '"';
+}
+
+std::string trace_events::dump()
+{
+	std::vector<std::shared_ptr<trace_buffer>> buffers;
+	{
+		std::lock_guard lock(s_trace_mutex);
+		buffers = s_trace_buffers;
+
+		// Forget buffers of finished threads, their events are dumped below for the last time
+		std::erase_if(s_trace_buffers, [](const std::shared_ptr<trace_buffer>& buf) { return buf.use_count() <= 2; });
+	}
+
+	const double tsc_to_us = 1000'000. / utils::get_tsc_freq();
+
+	std::vector<std::vector<trace_event>> events(buffers.size());
+
+	u64 base = umax;
+	usz total = 0;
+
+	for (usz i = 0; i < buffers.size(); i++)
+	{
+		const trace_buffer& buf = *buffers[i];
+
+		const u64 end = buf.pos.load();
+		const u64 begin = end > trace_buffer::capacity ? end - trace_buffer::capacity : 0;
+
+		for (u64 j = begin; j < end; j++)
+		{
+			events[i].emplace_back(buf.events[j % trace_buffer::capacity]);
+		}
+
+		// Drop events which might have been overwritten while copying
+		if (const u64 now = buf.pos.load(); now - begin >= trace_buffer::capacity)
+		{
+			events[i].erase(events[i].begin(), events[i].begin() + std::min<u64>(events[i].size(), now - begin - trace_buffer::capacity + 1));
+		}
+
+		for (const trace_event& e : events[i])
+		{
+			base = std::min(base, e.start);
+		}
+
+		total += events[i].size();
+	}
+
+	std::string out;
+	out.reserve(total * 96 + 4096);
+	out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool first = true;
+
+	for (usz i = 0; i < buffers.size(); i++)
+	{
+		if (!std::exchange(first, false))
+		{
+			out += ",\n";
+		}
+
+		fmt::append(out, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", i + 1);
+		append_json_string(out, buffers[i]->thread_name);
+		out += "}}";
+
+		for (const trace_event& e : events[i])
+		{
+			out += ",\n";
+			fmt::append(out, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"cat\":\"%s\",\"ts\":%.3f,\"dur\":%.3f,\"name\":", i + 1, e.cat, (e.start - base) * tsc_to_us, (e.end - e.start) * tsc_to_us);
+			append_json_string(out, {e.name, e.name_size});
+			out += '}';
+		}
+	}
+
+	out += "\n]}\n";
+
+	const std::string path = fs::get_cache_dir() + "trace_" + date_time::current_time_narrow<'_'>() + ".json";
+
+	if (!fs::write_file(path, fs::rewrite, out))
+	{
+		perf_log.error("Failed to write trace events to %s (%s)", path, fs::g_tls_error);
+		return {};
+	}
+
+	perf_log.success("Saved %u trace events of %u threads to %s", total, buffers.size(), path);
+	return path;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/tsc.hpp"
+#include "system_config.h"
+#include <string>
+#include <string_view>
+
+// Category of a trace event
+enum class trace_category : u8
+{
+	syscall,
+	hle,
+	spu,
+	rsx,
+};
+
+namespace trace_events
+{
+	// Record complete event (TSC timestamps) into the ring buffer of the current thread, name must be static
+	void record(trace_category cat, std::string_view name, u64 start, u64 end) noexcept;
+
+	// Write recorded events of all threads as Chrome trace-event JSON (viewable in Perfetto), return path
+	std::string dump();
+}
+
+// Object that records an event lasting until the end of its scope
+class trace_scope
+{
+	u64 m_start = 0;
+	std::string_view m_name;
+	trace_category m_cat{};
+
+public:
+	// Inactive scope, may be started later
+	trace_scope() noexcept = default;
+
+	FORCE_INLINE trace_scope(trace_category cat, std::string_view name) noexcept
+	{
+		start(cat, name);
+	}
+
+	trace_scope(const trace_scope&) = delete;
+
+	trace_scope& operator=(const trace_scope&) = delete;
+
+	FORCE_INLINE void start(trace_category cat, std::string_view name) noexcept
+	{
+		if (g_cfg.core.trace_events) [[unlikely]]
+		{
+			m_start = utils::get_tsc();
+			m_name = name;
+			m_cat = cat;
+		}
+	}
+
+	FORCE_INLINE ~trace_scope()
+	{
+		if (m_start) [[unlikely]]
+		{
+			trace_events::record(m_cat, m_name, m_start, utils::get_tsc());
+		}
+	}
+};
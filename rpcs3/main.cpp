@@ -29,6 +29,9 @@
 #include "headless_application.h"
 #include "Utilities/sema.h"
 #include "Crypto/decrypt_binaries.h"
+#include "Emu/Cell/lv2/sys_fs.h"
+#include "Emu/Cell/SPURecompiler.h"
+#include "Emu/Cell/lv2/sys_net/network_context.h"
 #ifdef _WIN32
 #include <windows.h>
 #include "util/dyn_lib.hpp"
@@ -264,6 +267,11 @@ struct fatal_error_listener final : logs::listener
 			Emu.Pause(true);
 		}
 	}
+
+	bool wants_text(const logs::message& msg) const override
+	{
+		return msg == logs::level::fatal;
+	}
 };
 
 // Arguments that force a headless application (need to be checked in create_application)
@@ -289,6 +297,17 @@ constexpr auto arg_savestate    = "savestate";
 constexpr auto arg_timer        = "high-res-timer";
 constexpr auto arg_verbose_curl = "verbose-curl";
 constexpr auto arg_any_location = "allow-any-location";
+constexpr auto arg_binary_log   = "binary-log";
+constexpr auto arg_decode_log   = "decode-log";
+constexpr auto arg_rsx_bench    = "rsx-bench";
+constexpr auto arg_rsx_bench_n  = "rsx-bench-iterations";
+constexpr auto arg_fs_bench     = "fs-bench";
+constexpr auto arg_fs_bench_bs  = "fs-bench-block";
+constexpr auto arg_jit_bench    = "jit-bench";
+constexpr auto arg_jit_bench_t  = "jit-bench-threads";
+constexpr auto arg_sched_bench  = "sched-bench";
+constexpr auto arg_idm_bench    = "idm-bench";
+constexpr auto arg_net_bench    = "net-bench";
 
 int find_arg(std::string arg, int& argc, char* argv[])
 {
@@ -303,7 +322,13 @@ QCoreApplication* create_application(int& argc, char* argv[])
 {
 	if (find_arg(arg_headless, argc, argv) != -1 ||
 		find_arg(arg_decrypt, argc, argv) != -1 ||
-		find_arg(arg_commit_db, argc, argv) != -1)
+		find_arg(arg_commit_db, argc, argv) != -1 ||
+		find_arg(arg_rsx_bench, argc, argv) != -1 ||
+		find_arg(arg_fs_bench, argc, argv) != -1 ||
+		find_arg(arg_jit_bench, argc, argv) != -1 ||
+		find_arg(arg_sched_bench, argc, argv) != -1 ||
+		find_arg(arg_idm_bench, argc, argv) != -1 ||
+		find_arg(arg_net_bench, argc, argv) != -1)
 	{
 		return new headless_application(argc, argv);
 	}
@@ -439,6 +464,27 @@ int main(int argc, char** argv)
 		report_fatal_error(error);
 	}
 
+	// Only convert binary log to text
+	if (int decode_pos = find_arg(arg_decode_log, argc, argv); decode_pos != -1)
+	{
+		if (decode_pos + 1 >= argc)
+		{
+			fprintf(stderr, "Missing path argument.\n");
+			return 1;
+		}
+
+		std::string src = argv[decode_pos + 1];
+		std::string dst = src.ends_with(".blog") ? src.substr(0, src.size() - 5) + ".log" : src + ".log";
+
+		if (!logs::decode_binary_log(src, dst, rpcs3::get_verbose_version()))
+		{
+			return 1;
+		}
+
+		fprintf(stdout, "Decoded log written to %s\n", dst.c_str());
+		return 0;
+	}
+
 	const std::string lock_name = fs::get_cache_dir() + "RPCS3.buf";
 
 	static fs::file instance_lock;
@@ -501,7 +547,15 @@ int main(int argc, char** argv)
 		}
 
 		// Limit log size to ~25% of free space
-		log_file = logs::make_file_listener(fs::get_cache_dir() + "RPCS3.log", stats.avail_free / 4);
+		if (find_arg(arg_binary_log, argc, argv) != -1)
+		{
+			// Unformatted log, use --decode-log to convert it to RPCS3.log format
+			log_file = logs::make_binary_file_listener(fs::get_cache_dir() + "RPCS3.blog", stats.avail_free / 4, rpcs3::get_verbose_version());
+		}
+		else
+		{
+			log_file = logs::make_file_listener(fs::get_cache_dir() + "RPCS3.log", stats.avail_free / 4);
+		}
 	}
 
 	static std::unique_ptr<logs::listener> fatal_listener = std::make_unique<fatal_error_listener>();
@@ -633,6 +687,26 @@ int main(int argc, char** argv)
 	parser.addOption(QCommandLineOption(arg_timer, "Enable high resolution timer for better performance (windows)", "enabled", "1"));
 	parser.addOption(QCommandLineOption(arg_verbose_curl, "Enable verbose curl logging."));
 	parser.addOption(QCommandLineOption(arg_any_location, "Allow RPCS3 to be run from any location. Dangerous"));
+	parser.addOption(QCommandLineOption(arg_binary_log, "Write RPCS3.blog with unformatted log records instead of RPCS3.log."));
+	parser.addOption(QCommandLineOption(arg_decode_log, "Convert binary log to text log.", "path", ""));
+	const QCommandLineOption rsx_bench_option(arg_rsx_bench, "Replay an RSX capture headlessly on the Null renderer and report CPU-side RSX statistics.", "path", "");
+	parser.addOption(rsx_bench_option);
+	const QCommandLineOption rsx_bench_n_option(arg_rsx_bench_n, "Number of replays for --rsx-bench.", "count", "100");
+	parser.addOption(rsx_bench_n_option);
+	const QCommandLineOption fs_bench_option(arg_fs_bench, "Read a host file sequentially into guest memory with sys_fs and report throughput.", "path", "");
+	parser.addOption(fs_bench_option);
+	const QCommandLineOption fs_bench_bs_option(arg_fs_bench_bs, "Read size in bytes for --fs-bench.", "size", "1048576");
+	parser.addOption(fs_bench_bs_option);
+	const QCommandLineOption jit_bench_option(arg_jit_bench, "Compile an SPU cache file (spu-*.dat), a PPU executable or a directory of PPU modules and report compilation statistics.", "path", "");
+	parser.addOption(jit_bench_option);
+	const QCommandLineOption jit_bench_t_option(arg_jit_bench_t, "Number of compiler threads for --jit-bench (0: use the LLVM threads setting).", "count", "0");
+	parser.addOption(jit_bench_t_option);
+	const QCommandLineOption sched_bench_option(arg_sched_bench, "Measure sleep/awake throughput of the lv2 scheduler timeout queue for up to the given number of waiting threads.", "threads", "4096");
+	parser.addOption(sched_bench_option);
+	const QCommandLineOption idm_bench_option(arg_idm_bench, "Measure idm::check/idm::get throughput on lv2 objects for up to the given number of threads (0: hardware threads).", "threads", "0");
+	parser.addOption(idm_bench_option);
+	const QCommandLineOption net_bench_option(arg_net_bench, "Measure loopback datagram latency and throughput of native and P2P sockets (P2P uses port 3658).", "iterations", "1000");
+	parser.addOption(net_bench_option);
 	parser.process(app->arguments());
 
 	// Don't start up the full rpcs3 gui if we just want the version or help.
@@ -1051,6 +1125,45 @@ int main(int argc, char** argv)
 		return 0;
 	}
 
+	// Run subsystem benchmark and exit
+	if (parser.isSet(arg_fs_bench) || parser.isSet(arg_sched_bench) || parser.isSet(arg_idm_bench) || parser.isSet(arg_net_bench) || (parser.isSet(arg_jit_bench) && parser.value(jit_bench_option).endsWith(".dat")))
+	{
+#ifdef _WIN32
+		if (AttachConsole(ATTACH_PARENT_PROCESS) || AllocConsole())
+		{
+			[[maybe_unused]] const auto con_out = freopen("CONOUT$", "w", stdout);
+		}
+#endif
+
+		bool success = false;
+
+		Emu.Init();
+
+		if (parser.isSet(arg_fs_bench))
+		{
+			success = lv2_file::read_benchmark(parser.value(fs_bench_option).toStdString(), parser.value(fs_bench_bs_option).toUInt());
+		}
+		else if (parser.isSet(arg_sched_bench))
+		{
+			success = lv2_obj::timeout_queue_benchmark(parser.value(sched_bench_option).toUInt());
+		}
+		else if (parser.isSet(arg_idm_bench))
+		{
+			success = lv2_obj::idm_lookup_benchmark(parser.value(idm_bench_option).toUInt());
+		}
+		else if (parser.isSet(arg_net_bench))
+		{
+			success = sys_net_loopback_benchmark(parser.value(net_bench_option).toUInt());
+		}
+		else
+		{
+			success = spu_cache::benchmark(parser.value(jit_bench_option).toStdString(), parser.value(jit_bench_t_option).toUInt());
+		}
+
+		Emu.Quit(true);
+		return success ? 0 : 1;
+	}
+
 	// Force install firmware or pkg first if specified through command-line
 	if (parser.isSet(arg_installfw) || parser.isSet(arg_installpkg))
 	{
@@ -1081,9 +1194,16 @@ int main(int argc, char** argv)
 				report_fatal_error("Cannot perform installation. No main window found!");
 			}
 		}
+		else if (parser.isSet(arg_installfw) && !parser.isSet(arg_installpkg))
+		{
+			// Install without user interaction and exit
+			const bool success = rpcs3::utils::install_pup(parser.value(installfw_option).toStdString());
+			Emu.Quit(true);
+			return success ? 0 : 1;
+		}
 		else
 		{
-			report_fatal_error("Cannot perform installation in headless mode!");
+			report_fatal_error("Cannot perform package installation in headless mode!");
 		}
 	}
 
@@ -1092,7 +1212,45 @@ int main(int argc, char** argv)
 		sys_log.notice("Option passed via command line: %s %s", opt.toStdString(), parser.value(opt).toStdString());
 	}
 
-	if (parser.isSet(arg_savestate))
+	if (parser.isSet(arg_rsx_bench))
+	{
+		const std::string capture_path = parser.value(rsx_bench_option).toStdString();
+		const u32 iterations = std::max(parser.value(rsx_bench_n_option).toUInt(), 1u);
+		sys_log.notice("Benchmarking rsx capture from command line: %s", capture_path);
+
+		if (!fs::is_file(capture_path))
+		{
+			report_fatal_error(fmt::format("No rsx capture file found: %s", capture_path));
+		}
+
+		Emu.CallFromMainThread([path = capture_path, iterations]()
+		{
+			if (!Emu.BootRsxCapture(path, iterations))
+			{
+				report_fatal_error(fmt::format("Booting rsx capture '%s' failed!", path));
+			}
+		});
+	}
+	else if (parser.isSet(arg_jit_bench))
+	{
+		const std::string bench_path = parser.value(jit_bench_option).toStdString();
+		const u32 threads = parser.value(jit_bench_t_option).toUInt();
+		sys_log.notice("Benchmarking PPU compilation from command line: %s", bench_path);
+
+		if (!fs::exists(bench_path))
+		{
+			report_fatal_error(fmt::format("No file or directory found: %s", bench_path));
+		}
+
+		Emu.CallFromMainThread([path = bench_path, threads]()
+		{
+			if (const game_boot_result error = Emu.BootJitBenchmark(path, threads); error != game_boot_result::no_errors)
+			{
+				report_fatal_error(fmt::format("Booting '%s' for compilation failed!\n\nReason: %s", path, error));
+			}
+		});
+	}
+	else if (parser.isSet(arg_savestate))
 	{
 		const std::string savestate_path = parser.value(savestate_option).toStdString();
 		sys_log.notice("Booting savestate from command line: %s", savestate_path);
@@ -84,6 +84,11 @@ struct gui_listener : logs::listener
 		}
 	}
 
+	bool wants_text(const logs::message& msg) const override
+	{
+		return msg <= enabled;
+	}
+
 	void pop()
 	{
 		pending.pop_front();
@@ -46,6 +46,7 @@
 #include "Emu/VFS.h"
 #include "Emu/vfs_config.h"
 #include "Emu/system_utils.hpp"
+#include "Emu/trace_events.hpp"
 
 #include "Crypto/unpkg.h"
 #include "Crypto/unself.h"
@@ -1271,44 +1272,26 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 	// Synchronization variable
 	atomic_t<uint> progress(0);
 	{
-		// Run asynchronously
+		// Run asynchronously, packages are installed in parallel
 		named_thread worker("Firmware Installer", [&]
 		{
-			for (const auto& update_filename : update_filenames)
+			switch (rpcs3::utils::install_firmware_packages(update_files, update_filenames, progress))
 			{
-				fs::file update_file = update_files.get_file(update_filename);
-
-				SCEDecrypter self_dec(update_file);
-				self_dec.LoadHeaders();
-				self_dec.LoadMetadata(SCEPKG_ERK, SCEPKG_RIV);
-				self_dec.DecryptData();
-
-				auto dev_flash_tar_f = self_dec.MakeFile();
-				if (dev_flash_tar_f.size() < 3)
-				{
-					gui_log.error("Error while installing firmware: PUP contents are invalid.");
-					critical(tr("Firmware installation failed: Firmware could not be decompressed"));
-					progress = -1;
-					return;
-				}
-
-				tar_object dev_flash_tar(dev_flash_tar_f[2]);
-				if (!dev_flash_tar.extract())
-				{
-					gui_log.error("Error while installing firmware: TAR contents are invalid. (package=%s)", update_filename);
-					critical(tr("The firmware contents could not be extracted."
-						"\nThis is very likely caused by external interference from a faulty anti-virus software."
-						"\nPlease add RPCS3 to your anti-virus\' whitelist or use better anti-virus software."));
-
-					progress = -1;
-					return;
-				}
-
-				if (!progress.try_inc(::narrow<uint>(update_filenames.size())))
-				{
-					// Installation was cancelled
-					return;
-				}
+			case rpcs3::utils::firmware_install_result::invalid_package:
+			{
+				critical(tr("Firmware installation failed: Firmware could not be decompressed"));
+				break;
+			}
+			case rpcs3::utils::firmware_install_result::extract_failed:
+			{
+				critical(tr("The firmware contents could not be extracted."
+					"\nThis is very likely caused by external interference from a faulty anti-virus software."
+					"\nPlease add RPCS3 to your anti-virus\' whitelist or use better anti-virus software."));
+				break;
+			}
+			case rpcs3::utils::firmware_install_result::success:
+			case rpcs3::utils::firmware_install_result::cancelled:
+				break;
 			}
 		});
 
@@ -2023,6 +2006,11 @@ void main_window::CreateConnects()
 		g_user_asked_for_frame_capture = true;
 	});
 
+	connect(ui->actionSave_Trace_Timeline, &QAction::triggered, this, []()
+	{
+		trace_events::dump();
+	});
+
 	connect(ui->bootSavestateAct, &QAction::triggered, this, &main_window::BootSavestate);
 
 	connect(ui->addGamesAct, &QAction::triggered, this, [this]()
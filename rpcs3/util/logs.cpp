@@ -7,6 +7,8 @@
 #include <cstdarg>
 #include <string>
 #include <unordered_map>
+#include <set>
+#include <deque>
 #include <thread>
 #include <chrono>
 #include <cstring>
@@ -39,6 +41,32 @@ static std::string default_string()
 // Thread-specific log prefix provider
 thread_local std::string(*g_tls_log_prefix)() = &default_string;
 
+static void default_raw_prefix(logs::raw_prefix& prefix)
+{
+	if (thread_ctrl::is_main())
+	{
+		prefix.set("");
+		return;
+	}
+
+	prefix.set("TID: %u", thread_ctrl::get_tid());
+}
+
+// Unformatted log prefix provider, only valid while g_tls_log_prefix matches its owner
+static thread_local logs::raw_prefix_provider s_tls_log_prefix_raw = &default_raw_prefix;
+static thread_local std::string(*s_tls_log_prefix_owner)() = &default_string;
+
+void logs::set_tls_raw_prefix(raw_prefix_provider provider)
+{
+	s_tls_log_prefix_raw = provider;
+	s_tls_log_prefix_owner = provider ? g_tls_log_prefix : nullptr;
+}
+
+logs::raw_prefix_provider logs::get_tls_raw_prefix()
+{
+	return s_tls_log_prefix_owner == g_tls_log_prefix ? s_tls_log_prefix_raw : nullptr;
+}
+
 // Another thread-specific callback
 thread_local void(*g_tls_log_control)(const char* fmt, u64 progress) = [](const char*, u64){};
 
@@ -113,6 +141,54 @@ namespace logs
 		void log(u64 stamp, const message& msg, const std::string& prefix, const std::string& text) override;
 	};
 
+	// Binary log record header, followed by u64 args[argc], prefix data (see binary_prefix) and string argument data
+	struct binary_record
+	{
+		u32 size; // Full record size
+		u32 tid; // Logger thread index
+		u64 stamp;
+		u64 msg; // Message address (channel and level)
+		u64 fmt; // Format string address (0 for preformatted text record, the text follows prefix data)
+		u64 sup; // Argument type info address
+		u64 kinds; // See binary_arg_kinds()
+		u32 argc;
+		u32 prefix; // Prefix size (umax if the prefix didn't change since the previous record of this thread)
+	};
+
+	// Binary log prefix header, followed by u64 args[argc] and string argument data
+	struct binary_prefix
+	{
+		u64 fmt; // Format string address
+		u64 sup; // Argument type info address
+		u64 kinds;
+		u32 argc;
+		u32 reserved;
+	};
+
+	// Binary log file header, followed by build identifier
+	struct binary_header
+	{
+		char magic[8];
+		u32 version;
+		u32 build_size;
+		u64 anchor; // Reference address to relocate pointers
+	};
+
+	constexpr u32 s_binary_version = 2;
+
+	struct binary_file_listener final : file_writer, public listener
+	{
+		binary_file_listener(const std::string& path, u64 max_size, std::string_view build);
+
+		~binary_file_listener() override;
+
+		// Write preformatted text record
+		void log(u64 stamp, const message& msg, const std::string& prefix, const std::string& text) override;
+
+		// Write message arguments without formatting, returns false if the record is too big
+		bool log_binary(u64 stamp, const message& msg, const char* fmt, const fmt_type_info* sup, u64 kinds, const u64* args, usz argc);
+	};
+
 	struct root_listener final : public listener
 	{
 		root_listener() = default;
@@ -125,6 +201,11 @@ namespace logs
 			// Do nothing
 		}
 
+		bool wants_text(const message&) const override
+		{
+			return false;
+		}
+
 		// Channel registry
 		std::unordered_multimap<std::string, channel*> channels{};
 
@@ -178,6 +259,12 @@ namespace logs
 	// Must be set to true in main()
 	static atomic_t<bool> g_init{false};
 
+	// Active binary file listener
+	static atomic_t<binary_file_listener*> g_binary{};
+
+	// Build file listener text line
+	static void append_log_line(std::string& out, u64 stamp, const message& msg, std::string_view prefix, std::string_view text);
+
 	void reset()
 	{
 		std::lock_guard lock(g_mutex);
@@ -328,7 +415,7 @@ logs::registerer::registerer(channel& _ch)
 	get_logger()->channels.emplace(_ch.name, &_ch);
 }
 
-void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) const
+void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, u64 kinds, ...) const
 {
 	// Get timestamp
 	const u64 stamp = get_stamp();
@@ -338,7 +425,8 @@ void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) co
 
 	// Get text, extract va_args
 	/*constinit thread_local*/ std::string text;
-	/*constinit thread_local*/ std::basic_string<u64> args;
+	/*constinit thread_local*/ std::basic_string<u64> heap_args;
+	u64 stack_args[20];
 
 	static constexpr fmt_type_info empty_sup{};
 
@@ -346,20 +434,62 @@ void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) co
 	for (auto v = sup; v && v->fmt_string; v++)
 		args_count++;
 
-	text.reserve(50000);
-	args.resize(args_count);
+	u64* args = stack_args;
+
+	if (args_count > std::size(stack_args))
+	{
+		heap_args.resize(args_count);
+		args = heap_args.data();
+	}
 
 	va_list c_args;
-	va_start(c_args, sup);
-	for (u64& arg : args)
-		arg = va_arg(c_args, u64);
+	va_start(c_args, kinds);
+	for (usz i = 0; i < args_count; i++)
+		args[i] = va_arg(c_args, u64);
 	va_end(c_args);
-	fmt::raw_append(text, fmt, sup ? sup : &empty_sup, args.data());
-	std::string prefix = g_tls_log_prefix();
 
 	// Get first (main) listener
 	listener* lis = get_logger();
 
+	// Try to write binary record and skip formatting if nobody else needs text
+	binary_file_listener* const bin = kinds && g_init ? g_binary.load() : nullptr;
+
+	if (bin && bin->log_binary(stamp, *this, fmt, sup, kinds, args, args_count))
+	{
+		listener* need_text = nullptr;
+
+		for (auto next = lis->m_next.load(); next; next = next->m_next)
+		{
+			if (next != bin && next->wants_text(*this))
+			{
+				need_text = next;
+				break;
+			}
+		}
+
+		if (need_text)
+		{
+			text.reserve(50000);
+			fmt::raw_append(text, fmt, sup ? sup : &empty_sup, args);
+			const std::string prefix = g_tls_log_prefix();
+
+			for (lis = need_text; lis; lis = lis->m_next)
+			{
+				if (lis != bin && lis->wants_text(*this))
+				{
+					lis->log(stamp, *this, prefix, text);
+				}
+			}
+		}
+
+		g_tls_log_control(fmt, -1);
+		return;
+	}
+
+	text.reserve(50000);
+	fmt::raw_append(text, fmt, sup ? sup : &empty_sup, args);
+	std::string prefix = g_tls_log_prefix();
+
 	if (!g_init)
 	{
 		std::lock_guard lock(g_mutex);
@@ -620,22 +750,21 @@ logs::file_listener::file_listener(const std::string& path, u64 max_size)
 	file_writer::log("\xEF\xBB\xBF", 3);
 }
 
-void logs::file_listener::log(u64 stamp, const logs::message& msg, const std::string& prefix, const std::string& _text)
+void logs::append_log_line(std::string& text, u64 stamp, const message& msg, std::string_view prefix, std::string_view _text)
 {
-	/*constinit thread_local*/ std::string text;
-	text.reserve(50000);
+	const usz start = text.size();
 
 	// Used character: U+00B7 (Middle Dot)
 	switch (msg)
 	{
-	case level::always:  text = reinterpret_cast<const char*>(u8"·A "); break;
-	case level::fatal:   text = reinterpret_cast<const char*>(u8"·F "); break;
-	case level::error:   text = reinterpret_cast<const char*>(u8"·E "); break;
-	case level::todo:    text = reinterpret_cast<const char*>(u8"·U "); break;
-	case level::success: text = reinterpret_cast<const char*>(u8"·S "); break;
-	case level::warning: text = reinterpret_cast<const char*>(u8"·W "); break;
-	case level::notice:  text = reinterpret_cast<const char*>(u8"·! "); break;
-	case level::trace:   text = reinterpret_cast<const char*>(u8"·T "); break;
+	case level::always:  text += reinterpret_cast<const char*>(u8"·A "); break;
+	case level::fatal:   text += reinterpret_cast<const char*>(u8"·F "); break;
+	case level::error:   text += reinterpret_cast<const char*>(u8"·E "); break;
+	case level::todo:    text += reinterpret_cast<const char*>(u8"·U "); break;
+	case level::success: text += reinterpret_cast<const char*>(u8"·S "); break;
+	case level::warning: text += reinterpret_cast<const char*>(u8"·W "); break;
+	case level::notice:  text += reinterpret_cast<const char*>(u8"·! "); break;
+	case level::trace:   text += reinterpret_cast<const char*>(u8"·T "); break;
 	}
 
 	// Print µs timestamp
@@ -648,7 +777,7 @@ void logs::file_listener::log(u64 stamp, const logs::message& msg, const std::st
 	if (stamp == 0)
 	{
 		// Workaround for first special messages to keep backward compatibility
-		text.clear();
+		text.resize(start);
 	}
 
 	if (!prefix.empty())
@@ -670,10 +799,198 @@ void logs::file_listener::log(u64 stamp, const logs::message& msg, const std::st
 
 	text += _text;
 	text += '\n';
+}
+
+void logs::file_listener::log(u64 stamp, const logs::message& msg, const std::string& prefix, const std::string& _text)
+{
+	/*constinit thread_local*/ std::string text;
+	text.reserve(50000);
+
+	append_log_line(text, stamp, msg, prefix, _text);
 
 	file_writer::log(text.data(), text.size());
 }
 
+logs::binary_file_listener::binary_file_listener(const std::string& path, u64 max_size, std::string_view build)
+	: file_writer(path, max_size)
+	, listener()
+{
+	binary_header header{};
+	std::memcpy(header.magic, "RPCS3LOG", 8);
+	header.version = s_binary_version;
+	header.build_size = static_cast<u32>(build.size());
+	header.anchor = reinterpret_cast<uptr>(&g_init);
+
+	std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+	data += build;
+	file_writer::log(data.data(), data.size());
+}
+
+logs::binary_file_listener::~binary_file_listener()
+{
+	binary_file_listener* _this = this;
+	g_binary.compare_exchange(_this, nullptr);
+}
+
+void logs::binary_file_listener::log(u64 stamp, const logs::message& msg, const std::string& prefix, const std::string& text)
+{
+	binary_record rec{};
+	rec.size = static_cast<u32>(sizeof(rec) + prefix.size() + text.size());
+	rec.stamp = stamp;
+	rec.msg = reinterpret_cast<uptr>(&msg);
+	rec.prefix = static_cast<u32>(prefix.size());
+
+	if (sizeof(rec) + prefix.size() + text.size() > 0xffffff)
+	{
+		// Too big for the ring buffer
+		return;
+	}
+
+	std::string data;
+	data.reserve(rec.size);
+	data.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+	data += prefix;
+	data += text;
+	file_writer::log(data.data(), data.size());
+}
+
+bool logs::binary_file_listener::log_binary(u64 stamp, const logs::message& msg, const char* fmt, const fmt_type_info* sup, u64 kinds, const u64* args, usz argc)
+{
+	// Logger thread index and the last prefix written from this thread
+	static atomic_t<u32> s_tid_ctr{0};
+	thread_local u32 s_tid = ++s_tid_ctr;
+	thread_local uchar s_prefix[1024];
+	thread_local usz s_prefix_size = umax;
+
+	alignas(8) uchar buf[4096];
+
+	binary_record rec{};
+	rec.tid = s_tid;
+	rec.stamp = stamp;
+	rec.msg = reinterpret_cast<uptr>(&msg);
+	rec.fmt = reinterpret_cast<uptr>(fmt);
+	rec.sup = reinterpret_cast<uptr>(sup);
+	rec.kinds = kinds;
+	rec.argc = static_cast<u32>(argc);
+
+	usz pos = sizeof(rec) + argc * sizeof(u64);
+
+	if (pos > sizeof(buf))
+	{
+		return false;
+	}
+
+	const auto put = [&](const void* data, usz size)
+	{
+		if (pos + size > sizeof(buf))
+		{
+			return false;
+		}
+
+		std::memcpy(buf + pos, data, size);
+		pos += size;
+		return true;
+	};
+
+	// Write argument values at the given offset (string sizes instead of pointers), followed by string data
+	const auto put_args = [&](usz at, u64 arg_kinds, const u64* arg_values, usz arg_count)
+	{
+		for (usz i = 0; i < arg_count; i++)
+		{
+			u64 value = arg_values[i];
+			std::string_view str;
+
+			switch ((arg_kinds >> (i * 3)) & 7)
+			{
+			case 1: break;
+			case 2: value = value ? (str = reinterpret_cast<const char*>(value)).size() : umax; break;
+			case 3: value = (str = *reinterpret_cast<const std::string*>(value)).size(); break;
+			case 4: value = (str = *reinterpret_cast<const std::string_view*>(value)).size(); break;
+			default: return false;
+			}
+
+			std::memcpy(buf + at + i * sizeof(u64), &value, sizeof(u64));
+
+			if (!str.empty() && !put(str.data(), str.size()))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	// Get the prefix without formatting if the thread provides its unformatted equivalent
+	raw_prefix raw{};
+	std::string text_prefix;
+
+	if (const auto provider = get_tls_raw_prefix())
+	{
+		provider(raw);
+	}
+	else
+	{
+		text_prefix = g_tls_log_prefix();
+		raw.set("%s", text_prefix);
+	}
+
+	const usz prefix_pos = pos;
+
+	binary_prefix header{};
+	header.fmt = reinterpret_cast<uptr>(raw.fmt);
+	header.sup = reinterpret_cast<uptr>(raw.sup);
+	header.kinds = raw.kinds;
+	header.argc = raw.argc;
+
+	if (!put(&header, sizeof(header)) || pos + raw.argc * sizeof(u64) > sizeof(buf))
+	{
+		return false;
+	}
+
+	pos += raw.argc * sizeof(u64);
+
+	if (!put_args(prefix_pos + sizeof(header), raw.kinds, raw.args, raw.argc))
+	{
+		return false;
+	}
+
+	// Only write the prefix if it changed (compare encoded data)
+	const usz prefix_size = pos - prefix_pos;
+
+	if (prefix_size == s_prefix_size && std::memcmp(buf + prefix_pos, s_prefix, prefix_size) == 0)
+	{
+		pos = prefix_pos;
+		rec.prefix = umax;
+	}
+	else
+	{
+		rec.prefix = static_cast<u32>(prefix_size);
+	}
+
+	if (!put_args(sizeof(rec), kinds, args, argc))
+	{
+		return false;
+	}
+
+	if (rec.prefix != umax)
+	{
+		if (prefix_size <= sizeof(s_prefix))
+		{
+			std::memcpy(s_prefix, buf + prefix_pos, prefix_size);
+			s_prefix_size = prefix_size;
+		}
+		else
+		{
+			s_prefix_size = umax;
+		}
+	}
+
+	rec.size = static_cast<u32>(pos);
+	std::memcpy(buf, &rec, sizeof(rec));
+	file_writer::log(reinterpret_cast<const char*>(buf), pos);
+	return true;
+}
+
 std::unique_ptr<logs::listener> logs::make_file_listener(const std::string& path, u64 max_size)
 {
 	std::unique_ptr<logs::listener> result = std::make_unique<logs::file_listener>(path, max_size);
@@ -682,3 +999,181 @@ std::unique_ptr<logs::listener> logs::make_file_listener(const std::string& path
 	result->add(result.get());
 	return result;
 }
+
+std::unique_ptr<logs::listener> logs::make_binary_file_listener(const std::string& path, u64 max_size, std::string_view build)
+{
+	auto result = std::make_unique<logs::binary_file_listener>(path, max_size, build);
+
+	// Register file listener
+	result->add(result.get());
+	g_binary = result.get();
+	return result;
+}
+
+bool logs::decode_binary_log(const std::string& src, const std::string& dst, std::string_view build)
+{
+	const fs::file file(src);
+
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open binary log: %s (%s)\n", src.c_str(), fmt::format("%s", fs::g_tls_error).c_str());
+		return false;
+	}
+
+	const std::vector<uchar> data = file.to_vector<uchar>();
+
+	binary_header header{};
+
+	if (data.size() < sizeof(header) || (std::memcpy(&header, data.data(), sizeof(header)), std::memcmp(header.magic, "RPCS3LOG", 8)) || header.version != s_binary_version)
+	{
+		fprintf(stderr, "Not a binary log file: %s\n", src.c_str());
+		return false;
+	}
+
+	if (sizeof(header) + header.build_size > data.size() || std::string_view(reinterpret_cast<const char*>(data.data() + sizeof(header)), header.build_size) != build)
+	{
+		// Format strings and type information can only be resolved by the same build
+		fprintf(stderr, "Binary log was written by a different build: %s\n", src.c_str());
+		return false;
+	}
+
+	// Relocation offset for pointers
+	const u64 delta = reinterpret_cast<uptr>(&g_init) - header.anchor;
+
+	// Known channels for validation
+	std::set<u64> channels;
+	{
+		std::lock_guard lock(g_mutex);
+
+		for (auto&& pair : get_logger()->channels)
+		{
+			channels.emplace(reinterpret_cast<uptr>(pair.second));
+		}
+	}
+
+	std::unordered_map<u32, std::string> prefixes;
+
+	// Output starts with UTF-8 BOM like the text log
+	std::string out = "\xEF\xBB\xBF";
+	std::string text;
+	std::vector<u64> args;
+	std::deque<std::string> strings;
+	std::deque<std::string_view> views;
+
+	usz pos = sizeof(header) + header.build_size;
+
+	while (pos < data.size())
+	{
+		binary_record rec{};
+
+		if (data.size() - pos < sizeof(rec) || (std::memcpy(&rec, data.data() + pos, sizeof(rec)), rec.size < sizeof(rec)) || rec.size > data.size() - pos)
+		{
+			fprintf(stderr, "Binary log is truncated at 0x%llx\n", static_cast<unsigned long long>(pos));
+			break;
+		}
+
+		const uchar* const ptr = data.data() + pos;
+		const u64 msg_addr = rec.msg + delta;
+		pos += rec.size;
+
+		if (!channels.count(msg_addr & -16))
+		{
+			fprintf(stderr, "Unknown log channel in binary log at 0x%llx\n", static_cast<unsigned long long>(pos - rec.size));
+			continue;
+		}
+
+		const auto& msg = *reinterpret_cast<const message*>(msg_addr);
+		std::string_view payload(reinterpret_cast<const char*>(ptr) + sizeof(rec), rec.size - sizeof(rec));
+
+		if (!rec.fmt)
+		{
+			// Preformatted text record
+			const std::string_view prefix = payload.substr(0, rec.prefix);
+			append_log_line(out, rec.stamp, msg, prefix, payload.substr(prefix.size()));
+			continue;
+		}
+
+		if (rec.argc > 20 || payload.size() < rec.argc * sizeof(u64))
+		{
+			fprintf(stderr, "Invalid record in binary log at 0x%llx\n", static_cast<unsigned long long>(pos - rec.size));
+			continue;
+		}
+
+		static constexpr fmt_type_info empty_sup{};
+
+		// Recreate arguments (string arguments follow the given data)
+		const auto read_args = [&](std::string_view& data, std::string_view& strs, u64 kinds, u32 argc)
+		{
+			args.assign(argc + 1, 0);
+			std::memcpy(args.data(), data.data(), argc * sizeof(u64));
+			data.remove_prefix(argc * sizeof(u64));
+
+			for (u32 i = 0; i < argc; i++)
+			{
+				const u64 kind = (kinds >> (i * 3)) & 7;
+
+				if (kind == 1 || (kind == 2 && args[i] == umax))
+				{
+					args[i] = kind == 1 ? args[i] : 0;
+					continue;
+				}
+
+				const std::string_view str = strs.substr(0, args[i]);
+				strs.remove_prefix(str.size());
+
+				auto& obj = strings.emplace_back(str);
+
+				switch (kind)
+				{
+				case 2: args[i] = reinterpret_cast<uptr>(obj.c_str()); break;
+				case 3: args[i] = reinterpret_cast<uptr>(&obj); break;
+				case 4: args[i] = reinterpret_cast<uptr>(&views.emplace_back(obj)); break;
+				}
+			}
+		};
+
+		strings.clear();
+		views.clear();
+
+		std::string_view arg_data = payload.substr(0, rec.argc * sizeof(u64));
+		payload.remove_prefix(arg_data.size());
+
+		if (rec.prefix != umax)
+		{
+			std::string_view prefix_data = payload.substr(0, rec.prefix);
+			payload.remove_prefix(prefix_data.size());
+
+			binary_prefix ph{};
+
+			if (prefix_data.size() < sizeof(ph) || (std::memcpy(&ph, prefix_data.data(), sizeof(ph)), ph.argc > 8) || prefix_data.size() - sizeof(ph) < ph.argc * sizeof(u64))
+			{
+				fprintf(stderr, "Invalid prefix in binary log at 0x%llx\n", static_cast<unsigned long long>(pos - rec.size));
+				continue;
+			}
+
+			prefix_data.remove_prefix(sizeof(ph));
+			std::string_view prefix_strs = prefix_data.substr(ph.argc * sizeof(u64));
+			read_args(prefix_data, prefix_strs, ph.kinds, ph.argc);
+
+			auto& prefix = prefixes[rec.tid];
+			prefix.clear();
+			fmt::raw_append(prefix, reinterpret_cast<const char*>(ph.fmt + delta), ph.sup ? reinterpret_cast<const fmt_type_info*>(ph.sup + delta) : &empty_sup, args.data());
+		}
+
+		read_args(arg_data, payload, rec.kinds, rec.argc);
+
+		text.clear();
+		fmt::raw_append(text, reinterpret_cast<const char*>(rec.fmt + delta), rec.sup ? reinterpret_cast<const fmt_type_info*>(rec.sup + delta) : &empty_sup, args.data());
+		append_log_line(out, rec.stamp, msg, prefixes[rec.tid], text);
+	}
+
+	fs::file out_file(dst, fs::rewrite);
+
+	if (!out_file || out_file.write(out.data(), out.size()) != out.size())
+	{
+		fprintf(stderr, "Failed to write decoded log: %s\n", dst.c_str());
+		return false;
+	}
+
+	return true;
+}
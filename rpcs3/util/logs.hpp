@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <initializer_list>
 #include "util/atomic.hpp"
@@ -52,8 +53,8 @@ namespace logs
 		inline explicit operator bool() const;
 
 	private:
-		// Send log message to global logger instance
-		void broadcast(const char*, const fmt_type_info*, ...) const;
+		// Send log message to global logger instance (kinds: see binary_arg_kinds_v)
+		void broadcast(const char*, const fmt_type_info*, u64 kinds, ...) const;
 
 		friend struct channel;
 	};
@@ -81,6 +82,12 @@ namespace logs
 		// Process log message
 		virtual void log(u64 stamp, const message& msg, const std::string& prefix, const std::string& text) = 0;
 
+		// Check if formatted text is required for the message (allows to skip formatting in binary log mode)
+		virtual bool wants_text(const message&) const
+		{
+			return true;
+		}
+
 		// Add new listener
 		static void add(listener*);
 
@@ -124,6 +131,96 @@ namespace logs
 #undef GEN_LOG_METHOD
 	};
 
+	// Binary log argument kind (0 if the argument must be formatted immediately)
+	template <typename T>
+	consteval u64 binary_arg_kind()
+	{
+		using type = fmt_unveil_t<T>;
+
+		if constexpr ((std::is_arithmetic_v<type> || std::is_enum_v<type>) && sizeof(type) <= 8)
+			return 1; // Raw value
+		else if constexpr (std::is_same_v<type, const char*>)
+			return 2; // Null-terminated string
+		else if constexpr (std::is_same_v<type, std::string>)
+			return 3;
+		else if constexpr (std::is_same_v<type, std::string_view>)
+			return 4;
+		else
+			return 0;
+	}
+
+	// Argument kinds packed by 3 bits, MSB set if the message can be written without formatting
+	template <typename... Args>
+	consteval u64 binary_arg_kinds()
+	{
+		if constexpr (sizeof...(Args) > 20)
+		{
+			return 0;
+		}
+		else
+		{
+			u64 result = u64{1} << 63;
+
+			// Extra element avoids zero-sized array
+			constexpr u64 kinds[]{binary_arg_kind<Args>()..., 0};
+
+			for (usz i = 0; i < sizeof...(Args); i++)
+			{
+				if (!kinds[i])
+				{
+					return 0;
+				}
+
+				result |= kinds[i] << (i * 3);
+			}
+
+			return result;
+		}
+	}
+
+	template <typename... Args>
+	constexpr u64 binary_arg_kinds_v = binary_arg_kinds<Args...>();
+
+	// Unformatted log prefix for binary log (string arguments must outlive the log call)
+	struct raw_prefix
+	{
+		const char* fmt = "";
+		const fmt_type_info* sup = nullptr;
+		u64 kinds = binary_arg_kinds_v<>;
+		u32 argc = 0;
+		u64 args[8]{};
+
+		template <typename... Args>
+		void set(const char* fmt, const Args&... args) noexcept
+		{
+			static_assert(sizeof...(Args) <= std::extent_v<decltype(raw_prefix::args)> && binary_arg_kinds_v<Args...>, "Unsupported log prefix arguments");
+
+			this->fmt = fmt;
+			this->kinds = binary_arg_kinds_v<Args...>;
+			this->argc = sizeof...(Args);
+
+			if constexpr (sizeof...(Args) > 0)
+			{
+				this->sup = fmt::type_info_v<Args...>;
+
+				usz i = 0;
+				((this->args[i++] = u64{fmt_unveil<Args>::get(args)}), ...);
+			}
+			else
+			{
+				this->sup = nullptr;
+			}
+		}
+	};
+
+	using raw_prefix_provider = void(*)(raw_prefix&);
+
+	// Set unformatted equivalent of the current thread's log prefix provider (must be called after setting g_tls_log_prefix)
+	void set_tls_raw_prefix(raw_prefix_provider provider);
+
+	// Get unformatted prefix provider of the current thread (nullptr if g_tls_log_prefix has no unformatted equivalent)
+	raw_prefix_provider get_tls_raw_prefix();
+
 	inline logs::message::operator bool() const
 	{
 		// Test if enabled
@@ -137,11 +234,11 @@ namespace logs
 		{
 			if constexpr (sizeof...(Args) > 0)
 			{
-				broadcast(fmt, fmt::type_info_v<Args...>, u64{fmt_unveil<Args>::get(args)}...);
+				broadcast(fmt, fmt::type_info_v<Args...>, binary_arg_kinds_v<Args...>, u64{fmt_unveil<Args>::get(args)}...);
 			}
 			else
 			{
-				broadcast(fmt, nullptr);
+				broadcast(fmt, nullptr, binary_arg_kinds_v<>);
 			}
 		}
 	}
@@ -178,6 +275,12 @@ namespace logs
 	// Called in main()
 	std::unique_ptr<logs::listener> make_file_listener(const std::string& path, u64 max_size);
 
+	// Called in main() instead of make_file_listener(): write unformatted binary records (build: build identifier)
+	std::unique_ptr<logs::listener> make_binary_file_listener(const std::string& path, u64 max_size, std::string_view build);
+
+	// Convert binary log to the text log format (build must match the one used for writing)
+	bool decode_binary_log(const std::string& src, const std::string& dst, std::string_view build);
+
 	// Called in main()
 	void set_init(std::initializer_list<stored_message>);
 }
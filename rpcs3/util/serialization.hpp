@@ -2,6 +2,7 @@
 
 #include "util/types.hpp"
 #include <vector>
+#include <memory>
 
 namespace utils
 {
@@ -32,11 +33,29 @@ namespace utils
 	template <typename T>
 	concept ListAlike = requires (T& obj) { obj.insert(obj.end(), std::declval<typename T::value_type>()); };
 
+	struct serial;
+
+	// Backend for streaming serialized data from/to a file instead of keeping all of it in memory
+	struct serialization_file_handler
+	{
+		serialization_file_handler() = default;
+		virtual ~serialization_file_handler() = default;
+
+		// Writing: consume all buffered data (size is 0)
+		// Reading: buffer the stream range [pos, pos + size), may discard the data preceding pos
+		virtual bool handle_file_op(serial& ar, usz pos, usz size) = 0;
+
+		// Writing: complete the file with the remaining buffered data
+		virtual bool finalize(serial& ar) = 0;
+	};
+
 	struct serial
 	{
 		std::vector<u8> data;
+		usz data_offset = 0; // Stream position of data[0], non-zero only when streaming through m_file_handler
 		usz pos = 0;
 		bool m_is_writing = true;
+		std::unique_ptr<serialization_file_handler> m_file_handler;
 
 		serial() = default;
 		serial(const serial&) = delete;
@@ -58,17 +77,42 @@ namespace utils
 			}
 		}
 
+		// Get pointer to the following bytes of the stream (deserialization), returns nullptr if not available
+		const u8* peek(usz size)
+		{
+			if (m_file_handler && pos + size > data_offset + data.size())
+			{
+				m_file_handler->handle_file_op(*this, pos, size);
+			}
+
+			if (pos < data_offset || pos - data_offset > data.size() || data.size() - (pos - data_offset) < size)
+			{
+				return nullptr;
+			}
+
+			return data.data() + (pos - data_offset);
+		}
+
+		// Let the file handler process the buffered data, only call it when no part of the buffer is going to be patched later
+		void breathe(bool forced = false)
+		{
+			if (m_file_handler && (forced || data.size() >= 0x400000))
+			{
+				m_file_handler->handle_file_op(*this, pos, 0);
+			}
+		}
+
 		bool raw_serialize(const void* ptr, usz size)
 		{
 			if (is_writing())
 			{
-				data.insert(data.begin() + pos, static_cast<const u8*>(ptr), static_cast<const u8*>(ptr) + size);
+				data.insert(data.begin() + (pos - data_offset), static_cast<const u8*>(ptr), static_cast<const u8*>(ptr) + size);
 				pos += size;
 				return true;
 			}
 
-			ensure(data.size() - pos >= size);
-			std::memcpy(const_cast<void*>(ptr), data.data() + pos, size);
+			const u8* src = ensure(peek(size));
+			std::memcpy(const_cast<void*>(ptr), src, size);
 			pos += size;
 			return true;
 		}
@@ -306,6 +350,7 @@ namespace utils
 			}
 
 			m_is_writing = false;
+			data_offset = 0;
 			pos = 0;
 		}
 
@@ -313,14 +358,16 @@ namespace utils
 		void clear()
 		{
 			data.clear();
+			m_file_handler.reset();
 			m_is_writing = true;
+			data_offset = 0;
 			pos = 0;
 		}
 
 		usz seek_end(usz backwards = 0)
 		{
 			ensure(pos >= backwards);
-			pos = data.size() - backwards;
+			pos = data_offset + data.size() - backwards;
 			return pos;
 		}
 
@@ -364,10 +411,9 @@ namespace utils
 				return {};
 			}
 
-			const usz left = data.size() - pos;
 	 		using type = std::remove_const_t<T>;
 
-			if (left >= sizeof(type))
+			if (peek(sizeof(type)))
 			{
 				u8 buf[sizeof(type)]{};
 				ensure(raw_serialize(buf, sizeof(buf)));
@@ -381,7 +427,8 @@ namespace utils
 		// Used when an invalid state is encountered somewhere in a place we can't check success code such as constructor)
 		bool is_valid() const
 		{
-			return pos <= data.size();
+			// Streamed data may not be buffered yet
+			return pos <= data_offset + data.size() || (m_file_handler && !is_writing() && pos != umax);
 		}
 	};
 }
@@ -3080,3 +3080,16 @@ inline auto gv_shuffle_right(A&& a)
 {
 	FOR_X64(unary_op, kIdPsrldq, kIdVpsrldq, std::forward<A>(a), Count);
 }
+
+// Reverse byte order in each 32-bit element
+inline v128 gv_rev32(const v128& a)
+{
+#if defined(__SSSE3__)
+	return _mm_shuffle_epi8(a, _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3));
+#elif defined(ARCH_X64)
+	const __m128i r = _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8));
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(r, 0xb1), 0xb1);
+#elif defined(ARCH_ARM64)
+	return vrev32q_u8(a);
+#endif
+}
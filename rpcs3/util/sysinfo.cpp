@@ -9,6 +9,7 @@
 #include "sysinfoapi.h"
 #include "subauth.h"
 #include "stringapiset.h"
+#include "psapi.h"
 #else
 #include <unistd.h>
 #include <sys/resource.h>
@@ -596,6 +597,35 @@ u64 utils::get_total_memory()
 #endif
 }
 
+u64 utils::get_peak_memory_usage()
+{
+#ifdef _WIN32
+	::PROCESS_MEMORY_COUNTERS counters{};
+
+	if (!::K32GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return 0;
+	}
+
+	return counters.PeakWorkingSetSize;
+#else
+	struct rusage usage{};
+
+	if (::getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0;
+	}
+
+#ifdef __APPLE__
+	// Reported in bytes
+	return usage.ru_maxrss;
+#else
+	// Reported in kilobytes
+	return usage.ru_maxrss * u64{1024};
+#endif
+#endif
+}
+
 u32 utils::get_thread_count()
 {
 	static const u32 g_count = []()
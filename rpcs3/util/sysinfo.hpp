@@ -59,6 +59,9 @@ namespace utils
 
 	u64 get_total_memory();
 
+	// Peak resident memory of the process (0 if unknown)
+	u64 get_peak_memory_usage();
+
 	u32 get_thread_count();
 
 	u32 get_cpu_family();